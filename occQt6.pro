@@ -27,7 +27,7 @@
 include(src/qmake-target-platform.pri)
 include(src/qmake-destination-path.pri)
 
-QT       += core gui svg openglwidgets
+QT       += core gui svg openglwidgets concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -95,6 +95,26 @@ HEADERS += \
     src/customtoolbutton.h \
     src/emptyspacerwidget.h \
     src/hirespixmap.h \
+    src/occareaselector.h \
+    src/occbenchmark.h \
+    src/occbooleanservice.h \
+    src/occframestats.h \
+    src/occjobengine.h \
+    src/occimage.h \
+    src/occimageexporter.h \
+    src/occinstancer.h \
+    src/occmesher.h \
+    src/occoffscreenrenderer.h \
+    src/occprogressindicator.h \
+    src/occselectionmodes.h \
+    src/occshadercache.h \
+    src/occstartupprofiler.h \
+    src/occstepimporter.h \
+    src/occstlreader.h \
+    src/occstatsoverlay.h \
+    src/occstyleregistry.h \
+    src/occtiledimageexporter.h \
+    src/occturntablerecorder.h \
     src/occview.h \
     src/occviewcontextmenu.h \
     src/occviewenums.h \
@@ -106,6 +126,25 @@ SOURCES += \
     src/customtoolbutton.cpp \
     src/emptyspacerwidget.cpp \
     src/main.cpp \
+    src/occareaselector.cpp \
+    src/occbenchmark.cpp \
+    src/occbooleanservice.cpp \
+    src/occframestats.cpp \
+    src/occimageexporter.cpp \
+    src/occinstancer.cpp \
+    src/occjobengine.cpp \
+    src/occmesher.cpp \
+    src/occoffscreenrenderer.cpp \
+    src/occprogressindicator.cpp \
+    src/occselectionmodes.cpp \
+    src/occshadercache.cpp \
+    src/occstartupprofiler.cpp \
+    src/occstepimporter.cpp \
+    src/occstlreader.cpp \
+    src/occstatsoverlay.cpp \
+    src/occstyleregistry.cpp \
+    src/occtiledimageexporter.cpp \
+    src/occturntablerecorder.cpp \
     src/occview.cpp \
     src/occviewcontextmenu.cpp \
     src/occwidget.cpp \
@@ -114,6 +153,34 @@ SOURCES += \
 RESOURCES += \
     icons.qrc
 
+# CONFIG+=iconatlas rasterizes the icons at build time with tools/iconatlas,
+# hiresPixmap() then copies them from the atlas instead of rendering the SVGs.
+# The heights should match the toolbar and small icon sizes of the target style.
+iconatlas {
+    ICONATLAS_DIR = $$BUILDPATH/$$DESTINATION_PATH/.iconatlas
+    ICONATLAS_HEADER = $$ICONATLAS_DIR/iconatlas.h
+    ICONATLAS_HEIGHTS = 16,24,32
+    win32: ICONATLAS_TOOL = $$ICONATLAS_DIR/tool/iconatlas.exe
+    else: ICONATLAS_TOOL = $$ICONATLAS_DIR/tool/iconatlas
+
+    iconatlas_tool.target = $$ICONATLAS_TOOL
+    iconatlas_tool.depends = $$PWD/tools/iconatlas/main.cpp $$PWD/src/hirespixmap.h
+    iconatlas_tool.commands = $(MKDIR) $$shell_path($$ICONATLAS_DIR/tool) $$escape_expand(\\n\\t) \
+        cd $$shell_path($$ICONATLAS_DIR/tool) && $$shell_quote($$QMAKE_QMAKE) $$shell_quote($$PWD/tools/iconatlas/iconatlas.pro) && $(MAKE)
+
+    iconatlas_header.target = $$ICONATLAS_HEADER
+    # the SVGs are inputs too, an edited icon has to regenerate the atlas
+    iconatlas_header.depends = $$ICONATLAS_TOOL $$PWD/icons.qrc \
+        $$files($$PWD/icons/*.svg) $$files($$PWD/icons/lucide/*.svg)
+    iconatlas_header.commands = $$shell_path($$ICONATLAS_TOOL) --heights $$ICONATLAS_HEIGHTS \
+        $$shell_quote($$PWD/icons.qrc) $$shell_quote($$ICONATLAS_HEADER)
+
+    QMAKE_EXTRA_TARGETS += iconatlas_tool iconatlas_header
+    PRE_TARGETDEPS += $$ICONATLAS_HEADER
+    INCLUDEPATH += $$ICONATLAS_DIR
+    DEFINES += OCCQT6_ICON_ATLAS
+}
+
 macx {
     QMAKE_MACOSX_DEPLOYMENT_TARGET = 11.0
 }
@@ -146,11 +213,30 @@ LIBS += \
     -lTKG3d \
     -lTKGeomAlgo \
     -lTKGeomBase \
+    -lTKMesh \
     -lTKOffset  \
     -lTKPrim \
     -lTKShHealing \
     -lTKTopAlgo
 
+# occ module application framework libs
+LIBS += \
+    -lTKCAF \
+    -lTKCDF \
+    -lTKLCAF \
+    -lTKVCAF
+
+# occ module data exchange libs
+LIBS += \
+    -lTKSTEP \
+    -lTKSTEP209 \
+    -lTKSTEPAttr \
+    -lTKSTEPBase \
+    -lTKSTL \
+    -lTKXCAF \
+    -lTKXDESTEP \
+    -lTKXSBase
+
 
 
 # Default rules for deployment.
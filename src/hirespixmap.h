@@ -29,40 +29,141 @@
 #ifndef HIRESPIXMAP_H
 #define HIRESPIXMAP_H
 
+#include <QCryptographicHash>
+#include <QDir>
 #include <QFile>
 #include <QFileInfo>
 #include <QPainter>
 #include <QPaintDevice>
 #include <QPixmap>
+#include <QPixmapCache>
+#include <QSaveFile>
 #include <QSvgRenderer>
-#include <QTextStream>
 
-inline QPixmap hiresPixmap(const QString &filename, int height)
+#ifdef OCCQT6_ICON_ATLAS
+#include "iconatlas.h"
+
+// Icon pre-rendered at build time by tools/iconatlas, null if the atlas lacks it.
+inline QPixmap iconAtlasPixmap(const QString &filename, int height, const QString &iconColor)
 {
-    //load svg and re-color accordingly
-    const QLatin1String iconColor {"#778ca3"}; //blue grey
+    if (iconColor != QLatin1String(iconAtlasColor))
+        return QPixmap();
+
+    static const QPixmap atlas = [] {
+        QPixmap pixmap;
+        pixmap.loadFromData(iconAtlasPng, sizeof(iconAtlasPng), "PNG");
+        return pixmap;
+    }();
+
+    for (const auto& entry : iconAtlasEntries)
+    {
+        if (entry.height == height && filename == QLatin1String(entry.resource))
+        {
+            QPixmap pixmap = atlas.copy(entry.x, entry.y, entry.width, entry.pixelHeight);
+            pixmap.setDevicePixelRatio(iconAtlasDevicePixelRatio);
+            return pixmap;
+        }
+    }
+    return QPixmap();
+}
+#endif
+
+// Directory of the optional on-disk cache of rasterized icons, disabled if empty.
+// Set it once at startup, before the first icon is created.
+inline QString& hiresPixmapDiskCacheDir()
+{
+    static QString dir;
+    return dir;
+}
 
+// SVG source of an icon, empty if the file does not exist.
+inline QByteArray readHiresPixmapSource(const QString &filename)
+{
+    QFile file(filename);
+    if (!QFileInfo(filename).isFile() || !file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return file.readAll();
+}
+
+inline QPixmap renderHiresPixmap(const QByteArray &source, int height, const QString &iconColor, qreal devicePixelRatio)
+{
     const int pixmapWidth = 144;
     const int pixmapHeight = 144;
     QPixmap pixmap(pixmapWidth, pixmapHeight);
     pixmap.fill(Qt::transparent);
 
-    if (QFileInfo::exists(filename) && QFileInfo(filename).isFile())
+    if (!source.isEmpty())
     {
-        QFile file(filename);
-        file.open(QIODevice::ReadOnly);
-        QTextStream in(&file);
-        QString icon = in.readAll();
+        QString icon = QString::fromUtf8(source);
         icon.replace("currentColor", iconColor);
         icon.replace("#000000", iconColor);
-        file.close();
         QSvgRenderer svg(QByteArray(icon.toUtf8()));
         QPainter painter(&pixmap);
         svg.render(&painter);
     }
-    pixmap.setDevicePixelRatio(2.0);
+    pixmap.setDevicePixelRatio(devicePixelRatio);
     pixmap = pixmap.scaledToHeight(4*height, Qt::SmoothTransformation);
 
     return pixmap;
 }
+
+inline QPixmap renderHiresPixmap(const QString &filename, int height, const QString &iconColor, qreal devicePixelRatio)
+{
+    return renderHiresPixmap(readHiresPixmapSource(filename), height, iconColor, devicePixelRatio);
+}
+
+// Rasterized icons are cached in memory for the whole process and, if a disk
+// cache directory is set, as PNG files that survive restarts. Builds with
+// CONFIG+=iconatlas look icons up in the atlas generated at build time first.
+inline QPixmap hiresPixmap(const QString &filename, int height, const QString &iconColor = "#778ca3" /*blue grey*/)
+{
+    const qreal devicePixelRatio = 2.0;
+    const QString key = QString("hiresPixmap|%1|%2|%3|%4")
+            .arg(filename).arg(height).arg(iconColor).arg(devicePixelRatio);
+
+    QPixmap pixmap;
+    if (QPixmapCache::find(key, &pixmap))
+        return pixmap;
+
+#ifdef OCCQT6_ICON_ATLAS
+    pixmap = iconAtlasPixmap(filename, height, iconColor);
+    if (!pixmap.isNull())
+    {
+        QPixmapCache::insert(key, pixmap);
+        return pixmap;
+    }
+#endif
+
+    const QByteArray source = readHiresPixmapSource(filename);
+
+    QString diskFile;
+    const QString& diskCacheDir = hiresPixmapDiskCacheDir();
+    if (!diskCacheDir.isEmpty())
+    {
+        // the SVG content is part of the key, an edited icon gets a new file
+        QCryptographicHash diskKey(QCryptographicHash::Md5);
+        diskKey.addData(key.toUtf8());
+        diskKey.addData(source);
+        diskFile = QDir(diskCacheDir).filePath(diskKey.result().toHex() + ".png");
+
+        if (pixmap.load(diskFile, "PNG"))
+        {
+            pixmap.setDevicePixelRatio(devicePixelRatio);
+            QPixmapCache::insert(key, pixmap);
+            return pixmap;
+        }
+    }
+
+    pixmap = renderHiresPixmap(source, height, iconColor, devicePixelRatio);
+    QPixmapCache::insert(key, pixmap);
+
+    if (!diskFile.isEmpty() && QDir().mkpath(diskCacheDir))
+    {
+        QSaveFile file(diskFile);
+        if (file.open(QIODevice::WriteOnly) && pixmap.save(&file, "PNG"))
+            file.commit();
+    }
+
+    return pixmap;
+}
 #endif // HIRESPIXMAP_H
@@ -30,13 +30,129 @@
 #include "occwidget.h"
 
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QStandardPaths>
+
+#include "hirespixmap.h"
+#include "occoffscreenrenderer.h"
+#include "occstartupprofiler.h"
+#include "occview.h"
+
+namespace
+{
+bool isHeadless(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; i++)
+        if (qstrcmp(argv[i], "--render") == 0)
+            return true;
+    return false;
+}
+
+// render every file from each requested view preset into the output directory
+int renderHeadless(const QCoreApplication& app)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Render shapes to images without opening a window.");
+    parser.addHelpOption();
+    parser.addOption({"render", "Render the given files offscreen and exit."});
+    parser.addOption({{"o", "output"}, "Output directory.", "dir", "."});
+    parser.addOption({"size", "Image size.", "WxH", "800x600"});
+    parser.addOption({"views", "Comma separated view presets (front, back, top, bottom, left, right, axo).", "views", "axo"});
+    parser.addOption({"format", "Image format (png, jpg, ...).", "format", "png"});
+    parser.addPositionalArgument("files", "BRep, STEP or STL files to render.", "files...");
+    parser.process(app);
+
+    const QStringList size = parser.value("size").split('x');
+    const int width = size.value(0).toInt();
+    const int height = size.value(1).toInt();
+    if (width <= 0 || height <= 0)
+    {
+        qCritical("invalid image size %s", qPrintable(parser.value("size")));
+        return 1;
+    }
+
+    QList<QPair<QString, occViewEnums::viewAction>> presets;
+    for (const auto& name : parser.value("views").split(',', Qt::SkipEmptyParts))
+    {
+        occViewEnums::viewAction preset;
+        if (!occView::viewPresetFromName(name, preset))
+        {
+            qCritical("unknown view preset %s", qPrintable(name));
+            return 1;
+        }
+        presets.append({name, preset});
+    }
+
+    const QDir outputDir(parser.value("output"));
+    if (!outputDir.exists() && !QDir().mkpath(outputDir.path()))
+    {
+        qCritical("cannot create %s", qPrintable(outputDir.path()));
+        return 1;
+    }
+
+    QString error;
+    occOffscreenRenderer renderer(width, height);
+    if (!renderer.init(&error))
+    {
+        qCritical("offscreen rendering is not available: %s", qPrintable(error));
+        return 1;
+    }
+
+    int nbFailed = 0;
+    for (const auto& fileName : parser.positionalArguments())
+    {
+        renderer.clear();
+        if (!renderer.loadShape(fileName, &error))
+        {
+            qWarning("%s", qPrintable(error));
+            nbFailed++;
+            continue;
+        }
+
+        for (const auto& preset : std::as_const(presets))
+        {
+            const QString imageName = outputDir.filePath(QString("%1_%2.%3")
+                                                         .arg(QFileInfo(fileName).completeBaseName(),
+                                                              preset.first,
+                                                              parser.value("format")));
+            if (!renderer.render(preset.second).save(imageName))
+            {
+                qWarning("cannot write %s", qPrintable(imageName));
+                nbFailed++;
+            }
+        }
+    }
+
+    return nbFailed == 0 ? 0 : 2;
+}
+}
 
 int main(int argc, char *argv[])
 {
+    // batch rendering never creates a widget and works without a display
+    if (isHeadless(argc, argv))
+    {
+        if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+
+        QGuiApplication app(argc, argv);
+        return renderHeadless(app);
+    }
+
     QCoreApplication::setAttribute (Qt::AA_UseDesktopOpenGL);
 
     QApplication a(argc, argv);
+    occStartupProfiler::mark("application created");
+
+    // keep rasterized icons across runs unless OCCQT6_NO_ICON_CACHE is set
+    if (!qEnvironmentVariableIsSet("OCCQT6_NO_ICON_CACHE"))
+        hiresPixmapDiskCacheDir() = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/icons";
+
     occWidget w;
     w.show();
+    occStartupProfiler::mark("main window shown");
     return a.exec();
 }
@@ -0,0 +1,410 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#include "occareaselector.h"
+
+// std headers
+#include <algorithm>
+
+// Qt headers
+#include <QtConcurrent/QtConcurrentMap>
+
+// occ headers
+#include <AIS_ConnectedInteractive.hxx>
+#include <AIS_Shape.hxx>
+#include <BRep_Tool.hxx>
+#include <Bnd_Box.hxx>
+#include <Graphic3d_Camera.hxx>
+#include <NCollection_Map.hxx>
+#include <Poly_Polygon3D.hxx>
+#include <Poly_PolygonOnTriangulation.hxx>
+#include <Poly_Triangulation.hxx>
+#include <SelectMgr_SensitiveEntity.hxx>
+#include <Standard_Version.hxx>
+#include <StdSelect_BRepOwner.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+
+// project headers
+#include "occselectionmodes.h"
+
+namespace
+{
+// owners tested by one task
+const int chunkSize {256};
+
+// world to window pixels, copied from the camera on the GUI thread
+struct windowProjection
+{
+    Graphic3d_Mat4d matrix;
+    double width {0.0};
+    double height {0.0};
+
+    bool project(const gp_Pnt& point, QPointF& pixel) const
+    {
+        const Graphic3d_Vec4d clip = matrix * Graphic3d_Vec4d(point.X(), point.Y(), point.Z(), 1.0);
+        if (clip.w() <= 0.0)
+            return false;
+
+        pixel.setX((clip.x() / clip.w() + 1.0) * 0.5 * width);
+        pixel.setY((1.0 - clip.y() / clip.w()) * 0.5 * height);
+        return true;
+    }
+};
+
+// selection area in window pixels
+struct selectionArea
+{
+    bool isRectangle {true};
+    QRectF bounds;
+    QPolygonF polygon;
+
+    bool contains(const QPointF& point) const
+    {
+        if (point.x() < bounds.left() || point.x() > bounds.right()
+                || point.y() < bounds.top() || point.y() > bounds.bottom())
+            return false;
+        return isRectangle || polygon.containsPoint(point, Qt::OddEvenFill);
+    }
+
+    bool intersects(const QRectF& rect) const
+    {
+        return rect.right() >= bounds.left() && rect.left() <= bounds.right()
+                && rect.bottom() >= bounds.top() && rect.top() <= bounds.bottom();
+    }
+};
+
+gp_Pnt triangulationNode(const Handle(Poly_Triangulation)& triangulation, Standard_Integer index)
+{
+#if OCC_VERSION_HEX >= 0x070600
+    return triangulation->Node(index);
+#else
+    return triangulation->Nodes().Value(index);
+#endif
+}
+
+// True if the shape has a discretization and all its points are inside the area.
+// Faces are tested by their triangulation nodes, edges by their polygons, vertices by their points.
+bool isInside(const TopoDS_Shape& shape, const gp_Trsf& trsf, const windowProjection& projection, const selectionArea& area)
+{
+    bool hasPoints = false;
+    auto contains = [&](const gp_Pnt& point) {
+        hasPoints = true;
+        QPointF pixel;
+        return projection.project(point, pixel) && area.contains(pixel);
+    };
+
+    for (TopExp_Explorer it(shape, TopAbs_FACE); it.More(); it.Next())
+    {
+        TopLoc_Location location;
+        const Handle(Poly_Triangulation)& triangulation = BRep_Tool::Triangulation(TopoDS::Face(it.Current()), location);
+        if (triangulation.IsNull())
+            continue;
+
+        const gp_Trsf nodeTrsf = trsf * location.Transformation();
+        for (Standard_Integer i = 1; i <= triangulation->NbNodes(); i++)
+        {
+            if (!contains(triangulationNode(triangulation, i).Transformed(nodeTrsf)))
+                return false;
+        }
+    }
+    if (hasPoints)
+        return true;
+
+    for (TopExp_Explorer it(shape, TopAbs_EDGE); it.More(); it.Next())
+    {
+        const TopoDS_Edge& edge = TopoDS::Edge(it.Current());
+
+        TopLoc_Location location;
+        const Handle(Poly_Polygon3D)& polygon = BRep_Tool::Polygon3D(edge, location);
+        if (!polygon.IsNull())
+        {
+            const gp_Trsf nodeTrsf = trsf * location.Transformation();
+            const TColgp_Array1OfPnt& nodes = polygon->Nodes();
+            for (Standard_Integer i = nodes.Lower(); i <= nodes.Upper(); i++)
+            {
+                if (!contains(nodes.Value(i).Transformed(nodeTrsf)))
+                    return false;
+            }
+            continue;
+        }
+
+        // edges of meshed faces are discretized on the triangulation
+        Handle(Poly_PolygonOnTriangulation) polygonOnTriangulation;
+        Handle(Poly_Triangulation) triangulation;
+        BRep_Tool::PolygonOnTriangulation(edge, polygonOnTriangulation, triangulation, location);
+        if (polygonOnTriangulation.IsNull() || triangulation.IsNull())
+            continue;
+
+        const gp_Trsf nodeTrsf = trsf * location.Transformation();
+        const TColStd_Array1OfInteger& indices = polygonOnTriangulation->Nodes();
+        for (Standard_Integer i = indices.Lower(); i <= indices.Upper(); i++)
+        {
+            if (!contains(triangulationNode(triangulation, indices.Value(i)).Transformed(nodeTrsf)))
+                return false;
+        }
+    }
+    if (hasPoints)
+        return true;
+
+    for (TopExp_Explorer it(shape, TopAbs_VERTEX); it.More(); it.Next())
+    {
+        if (!contains(BRep_Tool::Pnt(TopoDS::Vertex(it.Current())).Transformed(trsf)))
+            return false;
+    }
+    return hasPoints;
+}
+}
+
+
+occAreaSelector::occAreaSelector(const Handle(AIS_InteractiveContext)& context,
+                                 const Handle(V3d_View)& view,
+                                 const occSelectionModes* selectionModes,
+                                 QObject *parent)
+    : QObject(parent),
+      _context(context),
+      _view(view),
+      _selectionModes(selectionModes)
+{
+    connect(&_watcher, &QFutureWatcherBase::resultReadyAt, this, &occAreaSelector::consume);
+    connect(&_watcher, &QFutureWatcherBase::finished, this, &occAreaSelector::onFinished);
+}
+
+
+occAreaSelector::~occAreaSelector()
+{
+    _watcher.cancel();
+    _watcher.waitForFinished();
+}
+
+
+void occAreaSelector::select(const QVector<Graphic3d_Vec2i>& points, bool isRectangle, bool isXor)
+{
+    // a new area replaces the one still running
+    if (_isActive)
+    {
+        _watcher.cancel();
+        _watcher.waitForFinished();
+        _isActive = false;
+    }
+
+    if (points.size() < 2)
+        return;
+
+    _clock.start();
+    _updateClock.start();
+    _isActive = true;
+    _isXor = isXor;
+    _nbSelected = 0;
+    _chunks.clear();
+
+    selectionArea area;
+    area.isRectangle = isRectangle;
+    if (isRectangle)
+    {
+        area.bounds = QRectF(QPointF(points.first().x(), points.first().y()),
+                             QPointF(points.last().x(), points.last().y())).normalized();
+    }
+    else
+    {
+        for (const auto& point : points)
+            area.polygon.append(QPointF(point.x(), point.y()));
+        area.bounds = area.polygon.boundingRect();
+    }
+
+    windowProjection projection;
+    const Handle(Graphic3d_Camera)& camera = _view->Camera();
+    projection.matrix = camera->ProjectionMatrix() * camera->OrientationMatrix();
+    Standard_Integer width = 0, height = 0;
+    _view->Window()->Size(width, height);
+    projection.width = width;
+    projection.height = height;
+
+    if (!isXor)
+        _context->ClearSelected(Standard_False);
+
+    // owners of objects completely inside a rectangle need no further test
+    ownerList inside;
+
+    AIS_ListOfInteractive objects;
+    _context->DisplayedObjects(objects);
+    for (const auto& object : objects)
+    {
+        const int mode = _selectionModes->selectionMode(object);
+        if (mode < 0 || !object->HasSelection(mode)
+                || object->Selection(mode)->GetSelectionState() != SelectMgr_SOS_Activated)
+            continue;
+
+        Handle(AIS_Shape) shape = Handle(AIS_Shape)::DownCast(object);
+        Handle(AIS_ConnectedInteractive) connected = Handle(AIS_ConnectedInteractive)::DownCast(object);
+        if (shape.IsNull() && !connected.IsNull())
+            shape = Handle(AIS_Shape)::DownCast(connected->ConnectedTo());
+        if (shape.IsNull())
+            continue;
+
+        // the box is cached by AIS_Shape and given in the coordinates of the shape
+        const gp_Trsf trsf = object->Transformation();
+        Bnd_Box box;
+        shape->BoundingBox(box);
+        if (box.IsVoid())
+            continue;
+        box = box.Transformed(trsf);
+
+        Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+        box.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+
+        QRectF projected;
+        bool isProjected = true;
+        bool isBoxInside = true;
+        for (int corner = 0; corner < 8; corner++)
+        {
+            const gp_Pnt point((corner & 1) ? xMax : xMin, (corner & 2) ? yMax : yMin, (corner & 4) ? zMax : zMin);
+            QPointF pixel;
+            if (!projection.project(point, pixel))
+            {
+                isProjected = false;
+                break;
+            }
+            projected = corner == 0 ? QRectF(pixel, pixel) : projected.united(QRectF(pixel, pixel));
+            isBoxInside &= area.contains(pixel);
+        }
+
+        if (isProjected && !area.intersects(projected))
+            continue;
+
+        ownerList owners;
+        QVector<TopoDS_Shape> shapes;
+        if (mode == 0)
+        {
+            const Handle(SelectMgr_EntityOwner) owner = object->GlobalSelOwner();
+            if (!owner.IsNull())
+            {
+                owners.append(owner);
+                shapes.append(shape->Shape());
+            }
+        }
+        else
+        {
+            NCollection_Map<Handle(SelectMgr_EntityOwner)> visited;
+            const Handle(SelectMgr_Selection)& selection = object->Selection(mode);
+            for (NCollection_Vector<Handle(SelectMgr_SensitiveEntity)>::Iterator it(selection->Entities()); it.More(); it.Next())
+            {
+                const Handle(SelectMgr_EntityOwner)& owner = it.Value()->BaseSensitive()->OwnerId();
+                Handle(StdSelect_BRepOwner) brepOwner = Handle(StdSelect_BRepOwner)::DownCast(owner);
+                if (brepOwner.IsNull() || !visited.Add(owner))
+                    continue;
+                owners.append(owner);
+                shapes.append(brepOwner->Shape());
+            }
+        }
+
+        if (owners.isEmpty())
+            continue;
+
+        // a box inside a lasso can still cross its concave parts
+        if (isRectangle && isProjected && isBoxInside)
+        {
+            inside += owners;
+            continue;
+        }
+
+        for (int first = 0; first < owners.size(); first += chunkSize)
+            _chunks.append({trsf, owners.mid(first, chunkSize), shapes.mid(first, chunkSize)});
+    }
+
+    apply(inside);
+    if (!inside.isEmpty())
+        emit selectionChanged();
+
+    _isConsumed = QVector<bool>(_chunks.size(), false);
+    _watcher.setFuture(QtConcurrent::mapped(&_pool, _chunks, [projection, area](const chunk& item) {
+        ownerList result;
+        for (int i = 0; i < item.owners.size(); i++)
+        {
+            if (isInside(item.shapes.at(i), item.trsf, projection, area))
+                result.append(item.owners.at(i));
+        }
+        return result;
+    }));
+}
+
+
+void occAreaSelector::waitForFinished()
+{
+    _watcher.waitForFinished();
+    onFinished();
+}
+
+
+void occAreaSelector::consume(int index)
+{
+    if (!_isActive || index >= _isConsumed.size() || _isConsumed.at(index)
+            || !_watcher.future().isResultReadyAt(index))
+        return;
+
+    _isConsumed[index] = true;
+    apply(_watcher.resultAt(index));
+
+    // the highlighting is shown while the rest is still tested, at most 20 times per second
+    if (_updateClock.elapsed() > 50)
+    {
+        _updateClock.restart();
+        emit selectionChanged();
+    }
+}
+
+
+void occAreaSelector::apply(const ownerList& owners)
+{
+    for (const auto& owner : owners)
+    {
+        // the selection was cleared before, unless the owners are toggled
+        if (!_isXor && owner->IsSelected())
+            continue;
+
+        _context->AddOrRemoveSelected(owner, Standard_False);
+        ++_nbSelected;
+    }
+}
+
+
+void occAreaSelector::onFinished()
+{
+    if (!_isActive)
+        return;
+
+    // results whose signal is still queued
+    for (int index = 0; index < _isConsumed.size(); index++)
+        consume(index);
+
+    _isActive = false;
+    _chunks.clear();
+
+    emit selectionChanged();
+    emit finished(_nbSelected, _clock.nsecsElapsed() / 1.0e6);
+}
@@ -0,0 +1,123 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#ifndef OCCAREASELECTOR_H
+#define OCCAREASELECTOR_H
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QList>
+#include <QObject>
+#include <QPolygonF>
+#include <QThreadPool>
+#include <QVector>
+
+// occ headers
+#include <AIS_InteractiveContext.hxx>
+#include <Graphic3d_Vec.hxx>
+#include <SelectMgr_EntityOwner.hxx>
+#include <TopoDS_Shape.hxx>
+#include <V3d_View.hxx>
+#include <gp_Trsf.hxx>
+
+class occSelectionModes;
+
+/*
+  occAreaSelector selects everything inside a rectangle or lasso drawn in
+  the view, an alternative to AIS_InteractiveContext::Select() that stays
+  fast on scenes with hundreds of thousands of faces. The projected
+  bounding boxes of the objects are tested first: objects outside the area
+  are skipped, objects inside a rectangle are taken as a whole. The
+  triangulation nodes of the remaining owners are projected and tested on
+  worker threads, an owner is selected if all its nodes are inside, like
+  OpenCASCADE does by default. Results are added to the selection of the
+  context while the workers are still running.
+*/
+
+class occAreaSelector : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    // constructor
+    explicit occAreaSelector(const Handle(AIS_InteractiveContext)& context,
+                             const Handle(V3d_View)& view,
+                             const occSelectionModes* selectionModes,
+                             QObject *parent = nullptr);
+
+    // destructor, waits for the workers
+    ~occAreaSelector();
+
+    // Select the owners inside the area given in window pixels, two corners of a
+    // rectangle or the points of a lasso. Replaces the selection unless isXor is set.
+    void select(const QVector<Graphic3d_Vec2i>& points, bool isRectangle, bool isXor);
+
+    // apply all pending results, blocks the GUI thread
+    void waitForFinished();
+
+    bool isRunning() const {return _watcher.isRunning();}
+
+signals:
+    // owners were added, the viewer needs to be updated
+    void selectionChanged();
+    void finished(int nbSelected, double msecs);
+
+private:
+    // owners of an object tested by a worker, with their shapes
+    struct chunk
+    {
+        gp_Trsf trsf;
+        QVector<Handle(SelectMgr_EntityOwner)> owners;
+        QVector<TopoDS_Shape> shapes;
+    };
+
+    using ownerList = QVector<Handle(SelectMgr_EntityOwner)>;
+
+    Handle(AIS_InteractiveContext) _context;
+    Handle(V3d_View) _view;
+    const occSelectionModes* _selectionModes;
+
+    QThreadPool _pool;
+    QFutureWatcher<ownerList> _watcher;
+    QList<chunk> _chunks;
+    QVector<bool> _isConsumed;
+
+    bool _isActive {false};
+    bool _isXor {false};
+    int _nbSelected {0};
+    QElapsedTimer _clock;
+    QElapsedTimer _updateClock;
+
+    void consume(int index);
+    void apply(const ownerList& owners);
+    void onFinished();
+};
+
+#endif // OCCAREASELECTOR_H
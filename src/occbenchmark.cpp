@@ -0,0 +1,405 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#include "occbenchmark.h"
+
+// std headers
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+// Qt headers
+#include <QFile>
+#include <QJsonDocument>
+
+// occ headers
+#include <AIS_Shape.hxx>
+#include <BRepBuilderAPI_MakeEdge.hxx>
+#include <BRepBuilderAPI_MakeFace.hxx>
+#include <BRepBuilderAPI_MakeWire.hxx>
+#include <BRepLib.hxx>
+#include <BRepOffsetAPI_MakePipe.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <BRepPrimAPI_MakeSphere.hxx>
+#include <BRepPrimAPI_MakeTorus.hxx>
+#include <GCE2d_MakeSegment.hxx>
+#include <Geom_CylindricalSurface.hxx>
+#include <Graphic3d_Camera.hxx>
+#include <OSD_MemInfo.hxx>
+#include <Standard_Version.hxx>
+#include <TColStd_IndexedDataMapOfStringString.hxx>
+#include <gp_Circ.hxx>
+#include <gp_Lin2d.hxx>
+
+// project headers
+#include "occareaselector.h"
+#include "occselectionmodes.h"
+#include "occview.h"
+
+namespace
+{
+// the pipe of the cylindrical helix example
+TopoDS_Shape makeHelixPipe()
+{
+    const Standard_Real radius = 3.0;
+    const Standard_Real pitch = 1.0;
+
+    gp_Lin2d line2d(gp_Pnt2d(0.0, 0.0), gp_Dir2d(radius, pitch));
+    Handle(Geom2d_TrimmedCurve) segment = GCE2d_MakeSegment(line2d, 0.0, M_PI * 2.0).Value();
+    Handle(Geom_CylindricalSurface) cylinder = new Geom_CylindricalSurface(gp::XOY(), radius);
+    TopoDS_Edge helixEdge = BRepBuilderAPI_MakeEdge(segment, cylinder, 0.0, 6.0 * M_PI).Edge();
+    BRepLib::BuildCurve3d(helixEdge);
+
+    gp_Ax2 axis;
+    axis.SetDirection(gp_Dir(0.0, 4.0, 1.0));
+    axis.SetLocation(gp_Pnt(radius, 0.0, 0.0));
+
+    TopoDS_Edge profileEdge = BRepBuilderAPI_MakeEdge(gp_Circ(axis, 0.3)).Edge();
+    TopoDS_Wire profileWire = BRepBuilderAPI_MakeWire(profileEdge).Wire();
+    TopoDS_Face profileFace = BRepBuilderAPI_MakeFace(profileWire).Face();
+
+    BRepOffsetAPI_MakePipe pipeMaker(BRepBuilderAPI_MakeWire(helixEdge).Wire(), profileFace);
+    return pipeMaker.IsDone() ? pipeMaker.Shape() : TopoDS_Shape();
+}
+}
+
+
+occBenchmark::occBenchmark(occView* view, QObject *parent)
+    : QObject(parent),
+      _view(view)
+{
+    _frameTimer.setSingleShot(true);
+    _frameTimer.setInterval(0);
+    connect(&_frameTimer, &QTimer::timeout, this, &occBenchmark::renderFrame);
+
+    _populateTimer.setSingleShot(true);
+    _populateTimer.setInterval(0);
+    connect(&_populateTimer, &QTimer::timeout, this, &occBenchmark::populate);
+}
+
+
+void occBenchmark::start(const occBenchmarkSettings& settings)
+{
+    if (isRunning())
+        return;
+
+    _settings = settings;
+    _settings.nbObjects = std::clamp(_settings.nbObjects, 1, maxObjects);
+    _settings.nbFrames = std::max(1, _settings.nbFrames);
+
+    _frameTimes = occFrameStats(_settings.nbFrames);
+    _submitTimes = occFrameStats(_settings.nbFrames);
+    _memoryBefore = memoryInfo();
+    _memoryPopulated = QJsonObject();
+    _savedCounters = _view->getView()->RenderingParams().CollectedStats;
+    _runClock.invalidate();
+
+    // every prototype is only meshed once
+    _prototypes = {
+        {BRepPrimAPI_MakeBox(3.0, 4.0, 5.0).Shape(), Quantity_NOC_AZURE},
+        {BRepPrimAPI_MakeSphere(3.0).Shape(), Quantity_NOC_BLUE1},
+        {BRepPrimAPI_MakeTorus(3.0, 1.0).Shape(), Quantity_NOC_YELLOW},
+        {BRepPrimAPI_MakeCylinder(3.0, 5.0).Shape(), Quantity_NOC_RED},
+        {makeHelixPipe(), Quantity_NOC_CORAL}
+    };
+    _objects.clear();
+    _objects.reserve(_settings.nbObjects);
+    _nbPopulated = 0;
+    _populateMsecs = 0;
+    _isPopulating = true;
+    _populateTimer.start();
+}
+
+
+void occBenchmark::cancel()
+{
+    if (isRunning())
+        finish(true);
+}
+
+
+void occBenchmark::populate()
+{
+    if (!_isPopulating)
+        return;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const int nbPerRow = static_cast<int>(std::ceil(std::sqrt(_settings.nbObjects)));
+    const Standard_Real spacing = 10.0;
+
+    // one slice per event loop iteration, so the progress bar is painted in between
+    {
+        occSceneTransaction scene(_view, false);
+        while (_nbPopulated < _settings.nbObjects && timer.elapsed() < 50)
+        {
+            const int i = _nbPopulated++;
+            const prototype& proto = _prototypes.at(i % _prototypes.size());
+            if (proto.shape.IsNull())
+                continue;
+
+            gp_Trsf trsf;
+            trsf.SetTranslation(gp_Vec(spacing * (i % nbPerRow), spacing * (i / nbPerRow), 0.0));
+
+            Handle(AIS_Shape) shape = new AIS_Shape(proto.shape.Moved(TopLoc_Location(trsf)));
+            shape->SetColor(proto.color);
+            _view->display(shape);
+            _objects.append(shape);
+        }
+    }
+    _populateMsecs += timer.elapsed();
+    emit progress(10 * _nbPopulated / _settings.nbObjects);
+
+    if (_nbPopulated < _settings.nbObjects)
+    {
+        _populateTimer.start();
+        return;
+    }
+
+    _isPopulating = false;
+    _prototypes.clear();
+    startOrbit();
+}
+
+
+void occBenchmark::startOrbit()
+{
+    _memoryPopulated = memoryInfo();
+
+    // orbit around the scene at the distance of a fitted view
+    const Handle(V3d_View)& view = _view->getView();
+    view->SetProj(V3d_XposYnegZpos);
+    view->FitAll(0.01, Standard_False);
+    _center = view->Camera()->Center();
+    _distance = view->Camera()->Distance();
+    _height = 0.5 * _distance;
+
+    // let OpenCASCADE collect its own counters during the run
+    view->ChangeRenderingParams().CollectedStats = Graphic3d_RenderingParams::PerfCounters_All;
+
+    _frame = 0;
+    _runClock.start();
+    _frameClock.start();
+    _frameTimer.start();
+}
+
+
+void occBenchmark::renderFrame()
+{
+    if (!isRunning())
+        return;
+
+    // time since the previous frame was started, i.e. the full frame time
+    if (_frame > 0)
+        _frameTimes.add(_frameClock.nsecsElapsed() / 1.0e6);
+    _frameClock.restart();
+
+    if (_frame >= _settings.nbFrames)
+    {
+        finish(false);
+        return;
+    }
+
+    const Standard_Real angle = 2.0 * M_PI * _frame / _settings.nbFrames;
+    const gp_Pnt eye(_center.X() + _distance * std::cos(angle),
+                     _center.Y() + _distance * std::sin(angle),
+                     _center.Z() + _height);
+
+    const Handle(V3d_View)& view = _view->getView();
+    view->Camera()->SetEyeAndCenter(eye, _center);
+    view->Camera()->SetUp(gp::DZ());
+    view->Camera()->OrthogonalizeUp();
+
+    QElapsedTimer submitClock;
+    submitClock.start();
+    view->Redraw();
+    _submitTimes.add(submitClock.nsecsElapsed() / 1.0e6);
+
+    ++_frame;
+    emit progress(10 + 90 * _frame / _settings.nbFrames);
+    _frameTimer.start();
+}
+
+
+void occBenchmark::finish(bool isCancelled)
+{
+    _frameTimer.stop();
+    _populateTimer.stop();
+    _isPopulating = false;
+    _prototypes.clear();
+    const qint64 runMsecs = _runClock.isValid() ? _runClock.elapsed() : 0;
+    const int nbFrames = std::max(0, _frame);
+    _frame = -1;
+
+    const Handle(V3d_View)& view = _view->getView();
+
+    QJsonObject occtStats;
+    TColStd_IndexedDataMapOfStringString statsMap;
+    view->StatisticInformation(statsMap);
+    for (TColStd_IndexedDataMapOfStringString::Iterator it(statsMap); it.More(); it.Next())
+        occtStats.insert(QString::fromUtf8(it.Key().ToCString()), QString::fromUtf8(it.Value().ToCString()));
+
+    QJsonObject system;
+    TColStd_IndexedDataMapOfStringString diagnostics;
+    view->DiagnosticInformation(diagnostics, Graphic3d_DiagnosticInfo_Basic);
+    for (TColStd_IndexedDataMapOfStringString::Iterator it(diagnostics); it.More(); it.Next())
+        system.insert(QString::fromUtf8(it.Key().ToCString()), QString::fromUtf8(it.Value().ToCString()));
+    system.insert("Qt", QT_VERSION_STR);
+    system.insert("OpenCASCADE", OCC_VERSION_COMPLETE);
+
+    view->ChangeRenderingParams().CollectedStats = _savedCounters;
+
+    const QJsonArray selection = isCancelled ? QJsonArray() : measureSelection();
+    const QJsonObject memoryAfter = memoryInfo();
+
+    // repeated runs would pile up their scenes
+    {
+        occSceneTransaction scene(_view, false);
+        for (const auto& object : std::as_const(_objects))
+            _view->remove(object);
+    }
+    _objects.clear();
+
+    QJsonArray frameTimes;
+    for (const double msecs : _frameTimes.samples())
+        frameTimes.append(msecs);
+
+    const double fps = runMsecs > 0 ? 1000.0 * nbFrames / runMsecs : 0.0;
+
+    _report = QJsonObject {
+        {"objects", _settings.nbObjects},
+        {"frames", nbFrames},
+        {"cancelled", isCancelled},
+        {"populateMs", _populateMsecs},
+        {"runMs", runMsecs},
+        {"fps", fps},
+        {"frameTimeMs", statistics(_frameTimes)},
+        {"submitTimeMs", statistics(_submitTimes)},
+        {"frameTimes", frameTimes},
+        {"selection", selection},
+        {"memory", QJsonObject {{"before", _memoryBefore},
+                                {"populated", _memoryPopulated},
+                                {"after", memoryAfter}}},
+        {"occtStatistics", occtStats},
+        {"system", system}
+    };
+
+    if (!_settings.reportFile.isEmpty())
+    {
+        QFile file(_settings.reportFile);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+            file.write(QJsonDocument(_report).toJson());
+    }
+
+    emit finished(QString("%1 objects: %2 fps, frame time p50 %3 ms, p99 %4 ms")
+                  .arg(_settings.nbObjects)
+                  .arg(fps, 0, 'f', 1)
+                  .arg(_frameTimes.percentile(50), 0, 'f', 2)
+                  .arg(_frameTimes.percentile(99), 0, 'f', 2));
+}
+
+
+QJsonArray occBenchmark::measureSelection()
+{
+    const Handle(AIS_InteractiveContext)& context = _view->getContext();
+    const Handle(V3d_View)& view = _view->getView();
+
+    // the selection of all objects has to be active before
+    _view->getSelectionModes()->waitForFinished();
+
+    Standard_Integer width = 0, height = 0;
+    view->Window()->Size(width, height);
+
+    QJsonArray results;
+    for (const double fraction : {0.1, 0.25, 0.5, 1.0})
+    {
+        const int xMin = qRound(0.5 * (1.0 - fraction) * width);
+        const int yMin = qRound(0.5 * (1.0 - fraction) * height);
+        const int xMax = width - xMin;
+        const int yMax = height - yMin;
+
+        QElapsedTimer timer;
+        timer.start();
+#if OCC_VERSION_HEX >= 0x070600
+        context->SelectRectangle(Graphic3d_Vec2i(xMin, yMin), Graphic3d_Vec2i(xMax, yMax), view);
+#else
+        context->Select(xMin, yMin, xMax, yMax, view, Standard_False);
+#endif
+        const double contextMsecs = timer.nsecsElapsed() / 1.0e6;
+        const int contextSelected = context->NbSelected();
+
+        timer.restart();
+        _view->getAreaSelector()->select({Graphic3d_Vec2i(xMin, yMin), Graphic3d_Vec2i(xMax, yMax)}, true, false);
+        _view->getAreaSelector()->waitForFinished();
+        const double areaMsecs = timer.nsecsElapsed() / 1.0e6;
+        const int areaSelected = context->NbSelected();
+
+        context->ClearSelected(Standard_False);
+
+        results.append(QJsonObject {
+                           {"windowFraction", fraction},
+                           {"contextMs", contextMsecs},
+                           {"contextSelected", contextSelected},
+                           {"areaSelectorMs", areaMsecs},
+                           {"areaSelectorSelected", areaSelected}
+                       });
+    }
+
+    return results;
+}
+
+
+QJsonObject occBenchmark::memoryInfo()
+{
+    OSD_MemInfo info;
+    auto megabytes = [&info](OSD_MemInfo::Counter counter) {
+        const Standard_Size value = info.Value(counter);
+        return value == Standard_Size(-1) ? -1.0 : value / (1024.0 * 1024.0);
+    };
+
+    return QJsonObject {
+        {"privateMiB", megabytes(OSD_MemInfo::MemPrivate)},
+        {"workingSetMiB", megabytes(OSD_MemInfo::MemWorkingSet)},
+        {"heapUsageMiB", megabytes(OSD_MemInfo::MemHeapUsage)}
+    };
+}
+
+
+QJsonObject occBenchmark::statistics(const occFrameStats& stats)
+{
+    return QJsonObject {
+        {"mean", stats.mean()},
+        {"min", stats.minimum()},
+        {"max", stats.maximum()},
+        {"p50", stats.percentile(50)},
+        {"p95", stats.percentile(95)},
+        {"p99", stats.percentile(99)}
+    };
+}
@@ -0,0 +1,141 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#ifndef OCCBENCHMARK_H
+#define OCCBENCHMARK_H
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+
+// occ headers
+#include <AIS_InteractiveObject.hxx>
+#include <Graphic3d_RenderingParams.hxx>
+#include <Quantity_NameOfColor.hxx>
+#include <TopoDS_Shape.hxx>
+#include <gp_Pnt.hxx>
+
+// project headers
+#include "occframestats.h"
+
+class occView;
+
+struct occBenchmarkSettings
+{
+    int nbObjects {1000};   // primitives added to the scene, at most occBenchmark::maxObjects
+    int nbFrames {360};     // frames of the camera orbit
+    QString reportFile;     // JSON report, not written if empty
+};
+
+/*
+  occBenchmark fills the view with many primitives (boxes, spheres, tori,
+  cylinders and helix pipes), orbits the camera around them for a fixed
+  number of frames and records frame times, the time spent submitting each
+  frame, memory usage and OpenCASCADE's own frame statistics. Afterwards
+  rectangles of growing size are selected, with AIS_InteractiveContext and
+  with occAreaSelector, to compare selection times. The results
+  are written to a JSON report so runs on different machines and builds can
+  be compared. The scene is filled in slices so that the progress is shown,
+  and the primitives are removed again when the run ends.
+*/
+
+class occBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int maxObjects {100000};
+
+    // constructor
+    explicit occBenchmark(occView* view, QObject *parent = nullptr);
+
+    void start(const occBenchmarkSettings& settings);
+    bool isRunning() const {return _isPopulating || _frame >= 0;}
+
+    // the report of the last run
+    const QJsonObject& report() const {return _report;}
+
+public slots:
+    void cancel();
+
+signals:
+    void progress(int percent);
+    void finished(const QString& summary);
+
+private:
+    occView* _view;
+    occBenchmarkSettings _settings;
+    QTimer _frameTimer;
+
+    // populate state, the copies share the geometry of their prototype
+    struct prototype
+    {
+        TopoDS_Shape shape;
+        Quantity_NameOfColor color;
+    };
+    QList<prototype> _prototypes;
+    QTimer _populateTimer;
+    int _nbPopulated {0};
+    bool _isPopulating {false};
+    QVector<Handle(AIS_InteractiveObject)> _objects;
+
+    // orbit state
+    int _frame {-1};
+    gp_Pnt _center;
+    Standard_Real _distance {0.0};
+    Standard_Real _height {0.0};
+
+    // measurements
+    occFrameStats _frameTimes;
+    occFrameStats _submitTimes;
+    QElapsedTimer _frameClock;
+    QElapsedTimer _runClock;
+    qint64 _populateMsecs {0};
+    QJsonObject _memoryBefore;
+    QJsonObject _memoryPopulated;
+    QJsonObject _report;
+    Graphic3d_RenderingParams::PerfCounters _savedCounters {Graphic3d_RenderingParams::PerfCounters_NONE};
+
+    void populate();
+    void startOrbit();
+    void renderFrame();
+    void finish(bool isCancelled);
+
+    QJsonArray measureSelection();
+
+    static QJsonObject memoryInfo();
+    static QJsonObject statistics(const occFrameStats& stats);
+};
+
+#endif // OCCBENCHMARK_H
@@ -0,0 +1,160 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#include "occbooleanservice.h"
+
+// Qt headers
+#include <QDebug>
+#include <QElapsedTimer>
+
+// occ headers
+#include <BRepAlgoAPI_BooleanOperation.hxx>
+
+namespace
+{
+QString operationName(BOPAlgo_Operation operation)
+{
+    switch (operation)
+    {
+    case BOPAlgo_COMMON:
+        return "Common";
+    case BOPAlgo_FUSE:
+        return "Fuse";
+    case BOPAlgo_CUT:
+        return "Cut";
+    case BOPAlgo_CUT21:
+        return "Cut21";
+    case BOPAlgo_SECTION:
+        return "Section";
+    default:
+        return "Unknown";
+    }
+}
+
+TopTools_ListOfShape listOf(const TopoDS_Shape& shape)
+{
+    TopTools_ListOfShape list;
+    list.Append(shape);
+    return list;
+}
+}
+
+
+QString occBooleanReport::toString() const
+{
+    return QString("%1 of %2 argument(s) and %3 tool(s) %4 in %5 ms%6")
+            .arg(operation)
+            .arg(nbArguments)
+            .arg(nbTools)
+            .arg(isDone ? "done" : "failed")
+            .arg(msecs)
+            .arg(hasWarnings ? " with warnings" : "");
+}
+
+
+occBooleanService::occBooleanService(const occBooleanOptions& options)
+    : _options(options)
+{
+}
+
+
+void occBooleanService::configure(BRepAlgoAPI_BuilderAlgo& algo) const
+{
+    algo.SetRunParallel(_options.runParallel);
+    algo.SetUseOBB(_options.useOBB);
+    algo.SetGlue(_options.glue);
+    if (_options.fuzzyValue > 0.0)
+        algo.SetFuzzyValue(_options.fuzzyValue);
+}
+
+
+TopoDS_Shape occBooleanService::cut(const TopoDS_Shape& object, const TopoDS_Shape& tool,
+                                    const Message_ProgressRange& range)
+{
+    return run(BOPAlgo_CUT, listOf(object), listOf(tool), range);
+}
+
+
+TopoDS_Shape occBooleanService::fuse(const TopoDS_Shape& object, const TopoDS_Shape& tool,
+                                     const Message_ProgressRange& range)
+{
+    return run(BOPAlgo_FUSE, listOf(object), listOf(tool), range);
+}
+
+
+TopoDS_Shape occBooleanService::common(const TopoDS_Shape& object, const TopoDS_Shape& tool,
+                                       const Message_ProgressRange& range)
+{
+    return run(BOPAlgo_COMMON, listOf(object), listOf(tool), range);
+}
+
+
+TopoDS_Shape occBooleanService::cut(const TopoDS_Shape& object, const TopTools_ListOfShape& tools,
+                                    const Message_ProgressRange& range)
+{
+    return run(BOPAlgo_CUT, listOf(object), tools, range);
+}
+
+
+TopoDS_Shape occBooleanService::run(BOPAlgo_Operation operation,
+                                    const TopTools_ListOfShape& arguments,
+                                    const TopTools_ListOfShape& tools,
+                                    const Message_ProgressRange& range)
+{
+    BRepAlgoAPI_BooleanOperation algo;
+    algo.SetOperation(operation);
+    algo.SetArguments(arguments);
+    algo.SetTools(tools);
+    configure(algo);
+
+    return build(algo, operationName(operation), arguments.Extent(), tools.Extent(), range);
+}
+
+
+TopoDS_Shape occBooleanService::build(BRepAlgoAPI_BuilderAlgo& algo, const QString& operation,
+                                      int nbArguments, int nbTools, const Message_ProgressRange& range)
+{
+    QElapsedTimer timer;
+    timer.start();
+    algo.Build(range);
+
+    _lastReport.operation = operation;
+    _lastReport.nbArguments = nbArguments;
+    _lastReport.nbTools = nbTools;
+    _lastReport.msecs = timer.elapsed();
+    _lastReport.isDone = algo.IsDone() && !algo.HasErrors();
+    _lastReport.hasWarnings = algo.HasWarnings();
+
+    if (_options.isLogging)
+        qInfo().noquote() << "Boolean" << _lastReport.toString();
+
+    if (!_lastReport.isDone)
+        return TopoDS_Shape();
+
+    return algo.Shape();
+}
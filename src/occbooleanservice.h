@@ -0,0 +1,112 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#ifndef OCCBOOLEANSERVICE_H
+#define OCCBOOLEANSERVICE_H
+
+// Qt headers
+#include <QString>
+
+// occ headers
+#include <BOPAlgo_GlueEnum.hxx>
+#include <BOPAlgo_Operation.hxx>
+#include <BRepAlgoAPI_BuilderAlgo.hxx>
+#include <Message_ProgressRange.hxx>
+#include <TopTools_ListOfShape.hxx>
+#include <TopoDS_Shape.hxx>
+
+// settings applied to every Boolean operation
+struct occBooleanOptions
+{
+    bool runParallel {true};         // intersect pairs of sub-shapes on all cores
+    bool useOBB {true};              // filter interfering pairs with oriented bounding boxes
+    Standard_Real fuzzyValue {0.0};  // additional tolerance, 0 disables the fuzzy mode
+    BOPAlgo_GlueEnum glue {BOPAlgo_GlueOff};
+    bool isLogging {true};           // log the report of every operation
+};
+
+// timing of the last operation run by the service
+struct occBooleanReport
+{
+    QString operation;
+    int nbArguments {0};
+    int nbTools {0};
+    qint64 msecs {0};
+    bool isDone {false};
+    bool hasWarnings {false};
+
+    QString toString() const;
+};
+
+/*
+  occBooleanService runs BRepAlgoAPI Boolean operations with a common set
+  of options and reports how long each of them took. An instance is cheap,
+  create one per job so that several threads never share one.
+*/
+
+class occBooleanService
+{
+public:
+
+    // constructor
+    explicit occBooleanService(const occBooleanOptions& options = occBooleanOptions());
+
+    const occBooleanOptions& options() const {return _options;}
+    void setOptions(const occBooleanOptions& options) {_options = options;}
+
+    TopoDS_Shape cut(const TopoDS_Shape& object, const TopoDS_Shape& tool,
+                     const Message_ProgressRange& range = Message_ProgressRange());
+    TopoDS_Shape fuse(const TopoDS_Shape& object, const TopoDS_Shape& tool,
+                      const Message_ProgressRange& range = Message_ProgressRange());
+    TopoDS_Shape common(const TopoDS_Shape& object, const TopoDS_Shape& tool,
+                        const Message_ProgressRange& range = Message_ProgressRange());
+
+    // Subtract all tools from the object in a single intersection pass.
+    TopoDS_Shape cut(const TopoDS_Shape& object, const TopTools_ListOfShape& tools,
+                     const Message_ProgressRange& range = Message_ProgressRange());
+
+    // Run an operation on lists of arguments and tools. Returns a null shape on failure.
+    TopoDS_Shape run(BOPAlgo_Operation operation,
+                     const TopTools_ListOfShape& arguments,
+                     const TopTools_ListOfShape& tools,
+                     const Message_ProgressRange& range = Message_ProgressRange());
+
+    const occBooleanReport& lastReport() const {return _lastReport;}
+
+    // Apply the options to any algorithm of the Boolean component.
+    void configure(BRepAlgoAPI_BuilderAlgo& algo) const;
+
+private:
+    occBooleanOptions _options;
+    occBooleanReport _lastReport;
+
+    TopoDS_Shape build(BRepAlgoAPI_BuilderAlgo& algo, const QString& operation,
+                       int nbArguments, int nbTools, const Message_ProgressRange& range);
+};
+
+#endif // OCCBOOLEANSERVICE_H
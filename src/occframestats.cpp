@@ -0,0 +1,142 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#include "occframestats.h"
+
+// std headers
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+
+occFrameStats::occFrameStats(int capacity)
+    : _capacity(std::max(1, capacity))
+{
+    _samples.reserve(_capacity);
+}
+
+
+void occFrameStats::add(double msecs)
+{
+    if (_samples.size() < _capacity)
+    {
+        _samples.append(msecs);
+        return;
+    }
+
+    _samples[_next] = msecs;
+    _next = (_next + 1) % _capacity;
+}
+
+
+void occFrameStats::clear()
+{
+    _samples.clear();
+    _next = 0;
+}
+
+
+double occFrameStats::last() const
+{
+    if (_samples.isEmpty())
+        return 0.0;
+
+    const int index = _samples.size() < _capacity ? _samples.size() - 1
+                                                  : (_next + _capacity - 1) % _capacity;
+    return _samples.at(index);
+}
+
+
+double occFrameStats::mean() const
+{
+    if (_samples.isEmpty())
+        return 0.0;
+
+    return std::accumulate(_samples.cbegin(), _samples.cend(), 0.0) / _samples.size();
+}
+
+
+double occFrameStats::minimum() const
+{
+    if (_samples.isEmpty())
+        return 0.0;
+
+    return *std::min_element(_samples.cbegin(), _samples.cend());
+}
+
+
+double occFrameStats::maximum() const
+{
+    if (_samples.isEmpty())
+        return 0.0;
+
+    return *std::max_element(_samples.cbegin(), _samples.cend());
+}
+
+
+double occFrameStats::percentile(double p) const
+{
+    if (_samples.isEmpty())
+        return 0.0;
+
+    // nearest-rank percentile
+    QVector<double> sorted = _samples;
+    const int rank = static_cast<int>(std::ceil(std::clamp(p, 0.0, 100.0) / 100.0 * sorted.size()));
+    const int index = std::clamp(rank - 1, 0, static_cast<int>(sorted.size()) - 1);
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted.at(index);
+}
+
+
+QVector<int> occFrameStats::histogram(int nbBins, double maxMsecs) const
+{
+    QVector<int> bins(std::max(1, nbBins), 0);
+    if (maxMsecs <= 0.0)
+        return bins;
+
+    const double binWidth = maxMsecs / bins.size();
+    for (const double sample : _samples)
+    {
+        const int bin = std::min(static_cast<int>(sample / binWidth), static_cast<int>(bins.size()) - 1);
+        bins[std::max(0, bin)]++;
+    }
+    return bins;
+}
+
+
+QVector<double> occFrameStats::samples() const
+{
+    if (_samples.size() < _capacity)
+        return _samples;
+
+    QVector<double> ordered;
+    ordered.reserve(_capacity);
+    for (int i = 0; i < _capacity; i++)
+        ordered.append(_samples.at((_next + i) % _capacity));
+    return ordered;
+}
@@ -0,0 +1,72 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#ifndef OCCFRAMESTATS_H
+#define OCCFRAMESTATS_H
+
+// Qt headers
+#include <QVector>
+
+/*
+  occFrameStats keeps the most recent frame times (in milliseconds) in a
+  ring buffer and evaluates mean, percentiles and histograms over them.
+*/
+
+class occFrameStats
+{
+public:
+
+    // constructor, keeps at most capacity samples
+    explicit occFrameStats(int capacity = 1000);
+
+    void add(double msecs);
+    void clear();
+
+    int count() const {return _samples.size();}
+    double last() const;
+    double mean() const;
+    double minimum() const;
+    double maximum() const;
+
+    // p-th percentile (0..100) of the stored samples
+    double percentile(double p) const;
+
+    // number of samples in nbBins equally sized bins between 0 and maxMsecs,
+    // slower frames are counted in the last bin
+    QVector<int> histogram(int nbBins, double maxMsecs) const;
+
+    // samples in the order they were added
+    QVector<double> samples() const;
+
+private:
+    QVector<double> _samples;
+    int _capacity;
+    int _next {0};
+};
+
+#endif // OCCFRAMESTATS_H
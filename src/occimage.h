@@ -0,0 +1,74 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#ifndef OCCIMAGE_H
+#define OCCIMAGE_H
+
+#include <algorithm>
+#include <cstring>
+
+#include <QImage>
+
+#include <Image_PixMap.hxx>
+
+// Copy an OpenCASCADE pixmap into a QImage, top row first.
+// Returns a null image for formats without a QImage counterpart.
+inline QImage pixmapToImage(const Image_PixMap& pixmap)
+{
+    QImage::Format format = QImage::Format_Invalid;
+    switch (pixmap.Format())
+    {
+    case Image_Format_RGBA:
+        format = QImage::Format_RGBA8888;
+        break;
+    case Image_Format_RGB32:
+        format = QImage::Format_RGBX8888;
+        break;
+    case Image_Format_RGB:
+        format = QImage::Format_RGB888;
+        break;
+    case Image_Format_Gray:
+        format = QImage::Format_Grayscale8;
+        break;
+    default:
+        return QImage();
+    }
+
+    QImage image(static_cast<int>(pixmap.SizeX()), static_cast<int>(pixmap.SizeY()), format);
+    if (image.isNull())
+        return image;
+
+    // Row() takes care of bottom-up pixmaps
+    const size_t rowBytes = std::min(static_cast<size_t>(image.bytesPerLine()),
+                                     static_cast<size_t>(pixmap.SizeRowBytes()));
+    for (int row = 0; row < image.height(); row++)
+        std::memcpy(image.scanLine(row), pixmap.Row(row), rowBytes);
+
+    return image;
+}
+#endif // OCCIMAGE_H
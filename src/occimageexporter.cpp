@@ -0,0 +1,178 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#include "occimageexporter.h"
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QImageWriter>
+#include <QtConcurrent/QtConcurrentRun>
+
+// occ headers
+#include <Image_PixMap.hxx>
+#include <V3d_ImageDumpOptions.hxx>
+
+// project headers
+#include "occimage.h"
+
+
+occImageExporter::occImageExporter(QObject *parent)
+    : QObject(parent)
+{
+    // encoding is single threaded, two workers overlap consecutive exports
+    _pool.setMaxThreadCount(2);
+}
+
+
+occImageExporter::~occImageExporter()
+{
+    _pool.waitForDone();
+}
+
+
+QStringList occImageExporter::supportedFormats()
+{
+    const QList<QByteArray> available = QImageWriter::supportedImageFormats();
+
+    QStringList formats;
+    for (const char* format : {"png", "jpg", "webp"})
+    {
+        if (available.contains(format))
+            formats.append(format);
+    }
+    return formats;
+}
+
+
+void occImageExporter::setQueueLimits(int maxPending, qint64 maxPendingBytes)
+{
+    _maxPending = qMax(1, maxPending);
+    _maxPendingBytes = qMax<qint64>(1, maxPendingBytes);
+}
+
+
+bool occImageExporter::save(const Handle(V3d_View)& view, const QString& fileName, int quality)
+{
+    QString format = QFileInfo(fileName).suffix().toLower();
+    if (format == "jpeg")
+        format = "jpg";
+    if (!supportedFormats().contains(format))
+    {
+        emit failed(fileName, QString("unsupported image format \"%1\"").arg(format));
+        return false;
+    }
+
+    Standard_Integer width = 0;
+    Standard_Integer height = 0;
+    view->Window()->Size(width, height);
+    const qint64 bytes = qint64(width) * height * 4;
+
+    // the first export is always accepted, even if it exceeds the byte limit
+    if (_pending.size() >= _maxPending || (!_pending.isEmpty() && _pendingBytes + bytes > _maxPendingBytes))
+    {
+        emit failed(fileName, QString("%1 exports are still in progress").arg(_pending.size()));
+        return false;
+    }
+
+    // the readback needs the GL context and stays on the GUI thread
+    QElapsedTimer timer;
+    timer.start();
+
+    V3d_ImageDumpOptions options;
+    options.Width = width;
+    options.Height = height;
+    options.BufferType = format == "jpg" ? Graphic3d_BT_RGB : Graphic3d_BT_RGBA;
+
+    Handle(Image_PixMap) pixmap = new Image_PixMap();
+    if (!view->ToPixMap(*pixmap, options))
+    {
+        emit failed(fileName, "cannot read back the frame buffer");
+        return false;
+    }
+    const qint64 readbackMsecs = timer.elapsed();
+
+    auto watcher = new QFutureWatcher<outcome>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher] { onExportFinished(watcher); });
+
+    const bool wasBusy = isBusy();
+    _pending.append({fileName, qint64(pixmap->SizeBytes()), watcher});
+    _pendingBytes += qint64(pixmap->SizeBytes());
+    if (!wasBusy)
+        emit busyChanged(true);
+
+    watcher->setFuture(QtConcurrent::run(&_pool, [pixmap, fileName, format, quality, readbackMsecs] {
+        QElapsedTimer encodeTimer;
+        encodeTimer.start();
+
+        outcome out;
+        const QImage image = pixmapToImage(*pixmap);
+        if (image.isNull())
+        {
+            out.error = "unsupported pixel format";
+            return out;
+        }
+
+        QImageWriter writer(fileName, format.toLatin1());
+        writer.setQuality(quality);
+        if (!writer.write(image))
+            out.error = writer.errorString();
+
+        out.msecs = readbackMsecs + encodeTimer.elapsed();
+        return out;
+    }));
+
+    return true;
+}
+
+
+void occImageExporter::onExportFinished(QFutureWatcher<outcome>* watcher)
+{
+    QString fileName;
+    for (int i = 0; i < _pending.size(); i++)
+    {
+        if (_pending.at(i).watcher == watcher)
+        {
+            fileName = _pending.at(i).fileName;
+            _pendingBytes -= _pending.at(i).bytes;
+            _pending.removeAt(i);
+            break;
+        }
+    }
+
+    const outcome out = watcher->result();
+    watcher->deleteLater();
+
+    if (out.error.isEmpty())
+        emit saved(fileName, out.msecs);
+    else
+        emit failed(fileName, out.error);
+
+    if (!isBusy())
+        emit busyChanged(false);
+}
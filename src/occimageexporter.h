@@ -0,0 +1,103 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#ifndef OCCIMAGEEXPORTER_H
+#define OCCIMAGEEXPORTER_H
+
+// Qt headers
+#include <QFutureWatcher>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+
+// occ headers
+#include <V3d_View.hxx>
+
+/*
+  occImageExporter saves screenshots without blocking the GUI for longer
+  than the frame buffer readback. The pixmap is handed to a worker thread
+  for conversion and encoding with the Qt image writers, so several exports
+  can be in flight while the user keeps navigating. The number of pending
+  exports and the memory they hold are bounded, save() refuses new
+  exports while the queue is full.
+*/
+
+class occImageExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    // constructor
+    explicit occImageExporter(QObject *parent = nullptr);
+
+    // destructor, waits for pending exports
+    ~occImageExporter();
+
+    // Read back the view and encode it in the background. The format is taken
+    // from the file suffix, quality ranges from 0 to 100, -1 uses the default.
+    bool save(const Handle(V3d_View)& view, const QString& fileName, int quality = -1);
+
+    // the image formats of supportedFormats() that Qt can write on this system
+    static QStringList supportedFormats();
+
+    void setQueueLimits(int maxPending, qint64 maxPendingBytes);
+    int pendingCount() const {return _pending.size();}
+    qint64 pendingBytes() const {return _pendingBytes;}
+    bool isBusy() const {return !_pending.isEmpty();}
+
+signals:
+    void saved(const QString& fileName, qint64 msecs);
+    void failed(const QString& fileName, const QString& reason);
+    void busyChanged(bool isBusy);
+
+private:
+    struct outcome
+    {
+        QString error;
+        qint64 msecs {0};
+    };
+
+    struct pendingExport
+    {
+        QString fileName;
+        qint64 bytes;
+        QFutureWatcher<outcome>* watcher;
+    };
+
+    QThreadPool _pool;
+    QList<pendingExport> _pending;
+    qint64 _pendingBytes {0};
+    int _maxPending {8};
+    qint64 _maxPendingBytes {512ll * 1024 * 1024};
+
+    void onExportFinished(QFutureWatcher<outcome>* watcher);
+};
+
+#endif // OCCIMAGEEXPORTER_H
@@ -0,0 +1,79 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#include "occinstancer.h"
+
+// std headers
+#include <utility>
+
+// project headers
+#include "occmesher.h"
+#include "occview.h"
+
+
+occInstancer::occInstancer(occView* view, const occMesher* mesher, QObject *parent)
+    : QObject(parent),
+      _view(view),
+      _mesher(mesher)
+{
+}
+
+
+int occInstancer::addPrototype(const Handle(AIS_Shape)& prototype)
+{
+    // the triangulation is stored in the shape and shared by all placements
+    _mesher->meshShape(prototype->Shape());
+
+    _prototypes.append(prototype);
+    _instances.append(QVector<Handle(AIS_ConnectedInteractive)>());
+    return _prototypes.size() - 1;
+}
+
+
+Handle(AIS_ConnectedInteractive) occInstancer::place(int prototype, const gp_Trsf& placement)
+{
+    if (prototype < 0 || prototype >= _prototypes.size())
+        return Handle(AIS_ConnectedInteractive)();
+
+    Handle(AIS_ConnectedInteractive) instance = new AIS_ConnectedInteractive();
+    instance->Connect(_prototypes.at(prototype), placement);
+    _view->display(instance);
+
+    _instances[prototype].append(instance);
+    return instance;
+}
+
+
+void occInstancer::removeInstances(int prototype)
+{
+    if (prototype < 0 || prototype >= _prototypes.size())
+        return;
+
+    for (const auto& instance : std::exchange(_instances[prototype], QVector<Handle(AIS_ConnectedInteractive)>()))
+        _view->remove(instance);
+}
@@ -0,0 +1,82 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#ifndef OCCINSTANCER_H
+#define OCCINSTANCER_H
+
+// Qt headers
+#include <QObject>
+#include <QVector>
+
+// occ headers
+#include <AIS_ConnectedInteractive.hxx>
+#include <AIS_Shape.hxx>
+#include <gp_Trsf.hxx>
+
+class occMesher;
+class occView;
+
+/*
+  occInstancer displays many copies of the same geometry. A prototype is
+  registered and meshed once; every placement is an AIS_ConnectedInteractive
+  that references the presentation of the prototype with its own transform.
+  Triangulation, presentation and GPU buffers therefore exist once per
+  prototype, while each copy can still be selected on its own. Placements
+  are displayed through occView, so scene transactions apply.
+*/
+
+class occInstancer : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    // constructor
+    occInstancer(occView* view, const occMesher* mesher, QObject *parent = nullptr);
+
+    // Register a prototype and mesh its shape. The prototype itself is not displayed.
+    // Returns the index used by place().
+    int addPrototype(const Handle(AIS_Shape)& prototype);
+
+    // display a copy of the prototype at the given placement
+    Handle(AIS_ConnectedInteractive) place(int prototype, const gp_Trsf& placement);
+
+    // remove all copies of the prototype from the context, the prototype stays registered
+    void removeInstances(int prototype);
+
+    int nbPrototypes() const {return _prototypes.size();}
+    int nbInstances(int prototype) const {return _instances.value(prototype).size();}
+
+private:
+    occView* _view;
+    const occMesher* _mesher;
+    QVector<Handle(AIS_Shape)> _prototypes;
+    QVector<QVector<Handle(AIS_ConnectedInteractive)>> _instances;
+};
+
+#endif // OCCINSTANCER_H
@@ -0,0 +1,155 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#include "occjobengine.h"
+
+// std headers
+#include <exception>
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QtConcurrent/QtConcurrentRun>
+
+// occ headers
+#include <Message_ProgressScope.hxx>
+#include <Standard_Failure.hxx>
+
+// project headers
+#include "occmesher.h"
+
+
+occJobEngine::occJobEngine(const occMesher* mesher, QObject *parent)
+    : QObject(parent),
+      _mesher(mesher)
+{
+    // most algorithms run parallel internally, two jobs keep all cores busy
+    _pool.setMaxThreadCount(2);
+}
+
+
+occJobEngine::~occJobEngine()
+{
+    cancel();
+    _pool.waitForDone();
+}
+
+
+void occJobEngine::submit(const QString& name, const occJob& job)
+{
+    Handle(occProgressIndicator) indicator = new occProgressIndicator();
+    indicator->setProgressCallback([this](int percent) {
+        QMetaObject::invokeMethod(this, [this, percent] { emit progress(percent); }, Qt::QueuedConnection);
+    });
+
+    auto watcher = new QFutureWatcher<outcome>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher] { onJobFinished(watcher); });
+
+    const bool wasBusy = isBusy();
+    _jobs.append({name, watcher, indicator});
+    if (!wasBusy)
+        emit busyChanged(true);
+    emit jobStarted(name);
+
+    watcher->setFuture(QtConcurrent::run(&_pool, [this, name, job, indicator] {
+        return run(name, job, indicator);
+    }));
+}
+
+
+void occJobEngine::cancel()
+{
+    for (const auto& job : std::as_const(_jobs))
+        job.indicator->cancel();
+}
+
+
+occJobEngine::outcome occJobEngine::run(const QString& name, const occJob& job,
+                                        const Handle(occProgressIndicator)& indicator) const
+{
+    outcome out;
+    QElapsedTimer timer;
+    timer.start();
+
+    try
+    {
+        // modeling takes the larger part of the progress, meshing the rest
+        Message_ProgressScope scope(indicator->Start(), TCollection_AsciiString(name.toUtf8().constData()), 10);
+        out.result = job(scope.Next(8));
+
+        Message_ProgressScope meshScope(scope.Next(2), "Meshing", out.result.shapes.size());
+        for (const auto& item : std::as_const(out.result.shapes))
+        {
+            if (!meshScope.More())
+                break;
+            _mesher->meshShape(item.shape, meshScope.Next());
+        }
+        out.isCancelled = !scope.More();
+    }
+    catch (const Standard_Failure& failure)
+    {
+        out.error = QString::fromUtf8(failure.GetMessageString());
+    }
+    catch (const std::exception& exception)
+    {
+        // e.g. std::bad_alloc, would otherwise be rethrown by the watcher on the GUI thread
+        out.error = QString::fromUtf8(exception.what());
+    }
+
+    out.msecs = timer.elapsed();
+    return out;
+}
+
+
+void occJobEngine::onJobFinished(QFutureWatcher<outcome>* watcher)
+{
+    QString name;
+    for (int i = 0; i < _jobs.size(); i++)
+    {
+        if (_jobs.at(i).watcher == watcher)
+        {
+            name = _jobs.at(i).name;
+            _jobs.removeAt(i);
+            break;
+        }
+    }
+
+    const outcome out = watcher->result();
+    watcher->deleteLater();
+
+    if (!out.error.isEmpty())
+        emit jobFailed(name, out.error);
+    else if (out.isCancelled)
+        emit jobFailed(name, "cancelled");
+    else if (out.result.shapes.isEmpty())
+        emit jobFailed(name, "the operation did not produce a shape");
+    else
+        emit jobFinished(name, out.result, out.msecs);
+
+    if (!isBusy())
+        emit busyChanged(false);
+}
@@ -0,0 +1,129 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#ifndef OCCJOBENGINE_H
+#define OCCJOBENGINE_H
+
+// std headers
+#include <functional>
+
+// Qt headers
+#include <QFutureWatcher>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+
+// occ headers
+#include <Message_ProgressRange.hxx>
+#include <Quantity_Color.hxx>
+#include <TopoDS_Shape.hxx>
+
+// project headers
+#include "occprogressindicator.h"
+
+class occMesher;
+
+// a shape computed by a job, styled with setShapeAttributes() if hasColor is set
+struct occJobShape
+{
+    TopoDS_Shape shape;
+    Quantity_Color color;
+    bool hasColor {true};
+};
+
+// the shapes computed by a job and an optional report shown to the user
+struct occJobResult
+{
+    QList<occJobShape> shapes;
+    QString report;
+};
+
+using occJob = std::function<occJobResult(const Message_ProgressRange&)>;
+
+/*
+  occJobEngine runs modeling operations (booleans, fillets, sweeps, ...)
+  on a worker thread pool. Every job receives a Message_ProgressRange that
+  reports to the GUI and stops the algorithm on cancel(). The resulting
+  shapes are meshed on the same worker and handed back to the GUI thread
+  through jobFinished(), where they can be displayed without further work.
+*/
+
+class occJobEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    // constructor
+    explicit occJobEngine(const occMesher* mesher, QObject *parent = nullptr);
+
+    // destructor, cancels and waits for running jobs
+    ~occJobEngine();
+
+    // Run the job in the background, the name is used for progress and messages.
+    void submit(const QString& name, const occJob& job);
+
+    bool isBusy() const {return !_jobs.isEmpty();}
+
+public slots:
+    void cancel();
+
+signals:
+    void progress(int percent);
+    void jobStarted(const QString& name);
+    void jobFinished(const QString& name, const occJobResult& result, qint64 msecs);
+    void jobFailed(const QString& name, const QString& reason);
+    void busyChanged(bool isBusy);
+
+private:
+    struct outcome
+    {
+        occJobResult result;
+        QString error;
+        qint64 msecs {0};
+        bool isCancelled {false};
+    };
+
+    struct runningJob
+    {
+        QString name;
+        QFutureWatcher<outcome>* watcher;
+        Handle(occProgressIndicator) indicator;
+    };
+
+    const occMesher* _mesher;
+    QThreadPool _pool;
+    QList<runningJob> _jobs;
+
+    outcome run(const QString& name, const occJob& job,
+                const Handle(occProgressIndicator)& indicator) const;
+    void onJobFinished(QFutureWatcher<outcome>* watcher);
+};
+
+#endif // OCCJOBENGINE_H
@@ -0,0 +1,176 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#include "occmesher.h"
+
+// std headers
+#include <algorithm>
+#include <utility>
+
+// Qt headers
+#include <QtConcurrent/QtConcurrentRun>
+
+// occ headers
+#include <Bnd_Box.hxx>
+#include <BRepBndLib.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <IMeshTools_Parameters.hxx>
+#include <Message_ProgressScope.hxx>
+
+
+occMesher::occMesher(QObject *parent) : QObject(parent)
+{
+    // batches are meshed in the order they were added, BRepMesh runs in parallel inside each
+    _pool.setMaxThreadCount(1);
+}
+
+
+occMesher::~occMesher()
+{
+    cancel();
+    _pool.waitForDone();
+}
+
+
+void occMesher::setDrawer(const Handle(Prs3d_Drawer)& drawer)
+{
+    if (drawer.IsNull())
+        return;
+
+    _isRelative = drawer->TypeOfDeflection() == Aspect_TOD_RELATIVE;
+    _deviationCoefficient = drawer->DeviationCoefficient();
+    _maximalChordialDeviation = drawer->MaximalChordialDeviation();
+    _deviationAngle = drawer->DeviationAngle();
+}
+
+
+Standard_Real occMesher::deflection(const TopoDS_Shape& shape) const
+{
+    if (!_isRelative)
+        return _maximalChordialDeviation;
+
+    // same as StdPrs_ToolTriangulatedShape::GetDeflection(), which cannot be
+    // used here as it writes the result back into the drawer
+    Bnd_Box box;
+    BRepBndLib::Add(shape, box, Standard_False);
+    if (box.IsVoid())
+        return _maximalChordialDeviation;
+
+    if (box.IsOpen())
+    {
+        if (!box.HasFinitePart())
+            return _maximalChordialDeviation;
+        box = box.FinitePart();
+    }
+
+    Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+    box.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+    const Standard_Real diagonal = std::max({xMax - xMin, yMax - yMin, zMax - zMin});
+    return diagonal * _deviationCoefficient * 4.0;
+}
+
+
+bool occMesher::meshShape(const TopoDS_Shape& shape, const Message_ProgressRange& range) const
+{
+    if (shape.IsNull())
+        return false;
+
+    IMeshTools_Parameters parameters;
+    parameters.Deflection = deflection(shape);
+    parameters.Angle = _deviationAngle;
+    parameters.InParallel = Standard_True;
+
+    BRepMesh_IncrementalMesh mesher(shape, parameters, range);
+    return mesher.IsDone() && !range.UserBreak();
+}
+
+
+void occMesher::mesh(const occShapeList& shapes)
+{
+    if (shapes.isEmpty())
+        return;
+
+    // copy the topology on the GUI thread, the worker never touches the AIS objects
+    QList<TopoDS_Shape> topoShapes;
+    for (const auto& shape : shapes)
+        topoShapes.append(shape->Shape());
+
+    Handle(occProgressIndicator) indicator = new occProgressIndicator();
+    indicator->setProgressCallback([this](int percent) {
+        QMetaObject::invokeMethod(this, [this, percent] { emit progress(percent); }, Qt::QueuedConnection);
+    });
+
+    auto watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, shapes] {
+        onBatchFinished(watcher, shapes);
+    });
+
+    const bool wasBusy = isBusy();
+    _batches.append({watcher, indicator});
+    if (!wasBusy)
+        emit busyChanged(true);
+
+    watcher->setFuture(QtConcurrent::run(&_pool, [this, topoShapes, indicator] {
+        Message_ProgressScope scope(indicator->Start(), "Meshing", topoShapes.size());
+        for (const auto& shape : topoShapes)
+        {
+            if (!scope.More())
+                return false;
+            meshShape(shape, scope.Next());
+        }
+        return scope.More();
+    }));
+}
+
+
+void occMesher::cancel()
+{
+    for (const auto& item : std::as_const(_batches))
+        item.indicator->cancel();
+}
+
+
+void occMesher::onBatchFinished(QFutureWatcher<bool>* watcher, const occShapeList& shapes)
+{
+    for (int i = 0; i < _batches.size(); i++)
+    {
+        if (_batches.at(i).watcher == watcher)
+        {
+            _batches.removeAt(i);
+            break;
+        }
+    }
+
+    if (watcher->result())
+        emit meshed(shapes);
+
+    watcher->deleteLater();
+
+    if (!isBusy())
+        emit busyChanged(false);
+}
@@ -0,0 +1,113 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#ifndef OCCMESHER_H
+#define OCCMESHER_H
+
+// Qt headers
+#include <QFutureWatcher>
+#include <QList>
+#include <QObject>
+#include <QThreadPool>
+
+// occ headers
+#include <AIS_Shape.hxx>
+#include <Message_ProgressRange.hxx>
+#include <Prs3d_Drawer.hxx>
+
+// project headers
+#include "occprogressindicator.h"
+
+using occShapeList = QList<Handle(AIS_Shape)>;
+
+/*
+  occMesher triangulates shapes with BRepMesh_IncrementalMesh on a worker
+  thread before they are displayed. The deflection is derived from the same
+  drawer settings AIS uses, so the presentation computed inside Display()
+  finds a matching triangulation and does not mesh again on the GUI thread.
+*/
+
+class occMesher : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    // constructor
+    explicit occMesher(QObject *parent = nullptr);
+
+    // destructor, cancels and waits for running batches
+    ~occMesher();
+
+    // Take the deflection settings from a drawer, usually the default drawer
+    // of the interactive context. Must be called from the GUI thread.
+    void setDrawer(const Handle(Prs3d_Drawer)& drawer);
+
+    // Triangulate a single shape in parallel mode. Several threads may call this
+    // at the same time as long as their shapes share no faces, BRepMesh writes
+    // the triangulation into the faces. The callers mesh shapes they own: demo
+    // batches, the results of occJobEngine jobs and the distinct parts of a
+    // STEP file (placed instances of a part are not meshed again).
+    bool meshShape(const TopoDS_Shape& shape,
+                   const Message_ProgressRange& range = Message_ProgressRange()) const;
+
+    // Triangulate the shapes on the worker thread, meshed() is emitted when done.
+    void mesh(const occShapeList& shapes);
+
+    bool isBusy() const {return !_batches.isEmpty();}
+
+public slots:
+    void cancel();
+
+signals:
+    void progress(int percent);
+    void meshed(const occShapeList& shapes);
+    void busyChanged(bool isBusy);
+
+private:
+    struct batch
+    {
+        QFutureWatcher<bool>* watcher;
+        Handle(occProgressIndicator) indicator;
+    };
+
+    // batches run one after another, BRepMesh itself runs in parallel
+    QThreadPool _pool;
+    QList<batch> _batches;
+
+    // deflection settings copied from the drawer
+    bool _isRelative {true};
+    Standard_Real _deviationCoefficient {0.001};
+    Standard_Real _maximalChordialDeviation {0.1};
+    Standard_Real _deviationAngle {0.3490658503988659}; // 20 degrees
+
+    Standard_Real deflection(const TopoDS_Shape& shape) const;
+    void onBatchFinished(QFutureWatcher<bool>* watcher, const occShapeList& shapes);
+};
+
+#endif // OCCMESHER_H
@@ -0,0 +1,175 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#include "occoffscreenrenderer.h"
+
+// Qt headers
+#include <QFileInfo>
+
+// occ headers
+#include <AIS_Shape.hxx>
+#include <AIS_Triangulation.hxx>
+#include <Aspect_DisplayConnection.hxx>
+#include <Aspect_NeutralWindow.hxx>
+#include <BRep_Builder.hxx>
+#include <BRepTools.hxx>
+#include <Image_PixMap.hxx>
+#include <OpenGl_GraphicDriver.hxx>
+#include <Standard_Failure.hxx>
+#include <TopoDS_Shape.hxx>
+
+// project headers
+#include "occimage.h"
+#include "occshadercache.h"
+#include "occstepimporter.h"
+#include "occstlreader.h"
+#include "occview.h"
+
+
+occOffscreenRenderer::occOffscreenRenderer(int width, int height)
+    : _width(width),
+      _height(height)
+{
+}
+
+
+bool occOffscreenRenderer::init(QString* error)
+{
+    occShaderCache::configure();
+
+    try
+    {
+        Handle(Aspect_DisplayConnection) displayConnection = new Aspect_DisplayConnection();
+        Handle(OpenGl_GraphicDriver) graphicDriver = new OpenGl_GraphicDriver(displayConnection, Standard_False);
+
+        // nothing is ever presented on screen
+        graphicDriver->ChangeOptions().buffersNoSwap = Standard_True;
+        graphicDriver->ChangeOptions().swapInterval = 0;
+#if __APPLE__
+        graphicDriver->ChangeOptions().contextCompatible = false;
+#endif
+        if (!graphicDriver->InitContext())
+        {
+            if (error)
+                *error = "cannot create an OpenGL context";
+            return false;
+        }
+
+        _viewer = new V3d_Viewer(graphicDriver);
+        _viewer->SetDefaultLights();
+        _viewer->SetLightOn();
+
+        _context = new AIS_InteractiveContext(_viewer);
+        _context->SetDisplayMode(AIS_Shaded, Standard_False);
+
+        Handle(Aspect_NeutralWindow) window = new Aspect_NeutralWindow();
+        window->SetSize(_width, _height);
+        window->SetVirtual(Standard_True);
+
+        _view = _viewer->CreateView();
+        _view->SetWindow(window);
+        _view->SetBackgroundColor(Quantity_Color(.13, .13, .13, Quantity_TOC_sRGB));
+        _view->TriedronDisplay(Aspect_TOTP_LEFT_LOWER, Quantity_NOC_GOLD, 0.1, V3d_ZBUFFER);
+    }
+    catch (const Standard_Failure& failure)
+    {
+        if (error)
+            *error = QString::fromUtf8(failure.GetMessageString());
+        return false;
+    }
+
+    return true;
+}
+
+
+bool occOffscreenRenderer::loadShape(const QString& fileName, QString* error)
+{
+    TopoDS_Shape shape;
+    const QString suffix = QFileInfo(fileName).suffix().toLower();
+    if (suffix == "stl")
+    {
+        occStlReport report;
+        const Handle(Poly_Triangulation) triangulation = occStlReader::read(fileName, report, std::atomic_bool(false));
+        if (triangulation.IsNull())
+        {
+            if (error)
+                *error = report.error;
+            return false;
+        }
+
+        // the triangulation is shown as it is, without faces
+        Handle(AIS_Triangulation) mesh = new AIS_Triangulation(triangulation);
+        mesh->SetDisplayMode(0);
+        _context->Display(mesh, Standard_False);
+        return true;
+    }
+    else if (suffix == "step" || suffix == "stp")
+    {
+        shape = occStepImporter::readShape(fileName, error);
+        if (shape.IsNull())
+            return false;
+    }
+    else
+    {
+        BRep_Builder builder;
+        if (!BRepTools::Read(shape, fileName.toUtf8().constData(), builder) || shape.IsNull())
+        {
+            if (error)
+                *error = QString("cannot read %1").arg(fileName);
+            return false;
+        }
+    }
+
+    _context->Display(new AIS_Shape(shape), Standard_False);
+    return true;
+}
+
+
+void occOffscreenRenderer::clear()
+{
+    _context->RemoveAll(Standard_False);
+}
+
+
+QImage occOffscreenRenderer::render(occViewEnums::viewAction preset)
+{
+    occView::applyViewPreset(_view, preset);
+    return render();
+}
+
+
+QImage occOffscreenRenderer::render()
+{
+    _view->ZFitAll();
+
+    Image_PixMap pixmap;
+    if (!_view->ToPixMap(pixmap, _width, _height, Graphic3d_BT_RGBA))
+        return QImage();
+
+    return pixmapToImage(pixmap);
+}
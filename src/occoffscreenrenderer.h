@@ -0,0 +1,87 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#ifndef OCCOFFSCREENRENDERER_H
+#define OCCOFFSCREENRENDERER_H
+
+// Qt headers
+#include <QImage>
+#include <QString>
+
+// occ headers
+#include <AIS_InteractiveContext.hxx>
+#include <V3d_View.hxx>
+#include <V3d_Viewer.hxx>
+
+// project headers
+#include "occviewenums.h"
+
+/*
+  occOffscreenRenderer renders into an offscreen frame buffer without any
+  widget or mapped window. The view is attached to a virtual
+  Aspect_NeutralWindow and images are read back with V3d_View::ToPixMap,
+  so the image size does not depend on a screen. On Linux servers without
+  a display this needs an OpenCASCADE build with EGL (e.g. Mesa llvmpipe)
+  or a virtual X server.
+*/
+
+class occOffscreenRenderer
+{
+public:
+
+    // constructor, the size is the size of the rendered images
+    occOffscreenRenderer(int width, int height);
+
+    // Create the graphic driver, viewer and view. Returns false on failure.
+    bool init(QString* error = nullptr);
+
+    // Load a shape file (BRep or STEP) and display it. Returns false on failure.
+    bool loadShape(const QString& fileName, QString* error = nullptr);
+
+    // Remove all displayed objects.
+    void clear();
+
+    // Apply a standard view preset and render the scene.
+    QImage render(occViewEnums::viewAction preset);
+
+    // Render the scene with the current camera.
+    QImage render();
+
+    const Handle(V3d_View)& getView() const {return _view;}
+    const Handle(AIS_InteractiveContext)& getContext() const {return _context;}
+
+private:
+    int _width;
+    int _height;
+
+    Handle(V3d_Viewer) _viewer;
+    Handle(V3d_View) _view;
+    Handle(AIS_InteractiveContext) _context;
+};
+
+#endif // OCCOFFSCREENRENDERER_H
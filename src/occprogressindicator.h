@@ -0,0 +1,76 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#ifndef OCCPROGRESSINDICATOR_H
+#define OCCPROGRESSINDICATOR_H
+
+// std headers
+#include <atomic>
+#include <functional>
+
+// occ headers
+#include <Message_ProgressIndicator.hxx>
+
+/*
+  occProgressIndicator forwards the progress of OpenCASCADE algorithms
+  running on a worker thread to a callback and lets the GUI thread stop
+  them. Algorithms poll UserBreak() through their Message_ProgressRange,
+  so cancel() is honoured at the next progress step.
+*/
+
+class occProgressIndicator : public Message_ProgressIndicator
+{
+    DEFINE_STANDARD_RTTIEXT(occProgressIndicator, Message_ProgressIndicator)
+
+public:
+
+    // constructor
+    occProgressIndicator() = default;
+
+    // Set the function receiving the overall progress in percent.
+    // It is called from the computing thread.
+    void setProgressCallback(std::function<void(int)> callback) {_callback = std::move(callback);}
+
+    // Request the running algorithm to stop, may be called from any thread.
+    void cancel() {_isCancelled = true;}
+    bool isCancelled() const {return _isCancelled;}
+
+    virtual Standard_Boolean UserBreak() override {return _isCancelled;}
+
+    virtual void Show(const Message_ProgressScope& theScope,
+                      const Standard_Boolean isForce) override;
+
+private:
+    std::function<void(int)> _callback;
+    std::atomic_bool _isCancelled {false};
+    std::atomic_int _lastPercent {-1};
+};
+
+DEFINE_STANDARD_HANDLE(occProgressIndicator, Message_ProgressIndicator)
+
+#endif // OCCPROGRESSINDICATOR_H
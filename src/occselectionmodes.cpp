@@ -0,0 +1,250 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#include "occselectionmodes.h"
+
+// std headers
+#include <utility>
+
+// Qt headers
+#include <QtConcurrent/QtConcurrentMap>
+
+// occ headers
+#include <AIS_ConnectedInteractive.hxx>
+#include <AIS_Shape.hxx>
+#include <SelectMgr_SensitiveEntity.hxx>
+#include <Standard_Version.hxx>
+
+
+occSelectionModes::occSelectionModes(const Handle(AIS_InteractiveContext)& context, QObject *parent)
+    : QObject(parent),
+      _context(context)
+{
+    // OCCT 7.6 and later can build the object level BVH in its own threads as well
+#if OCC_VERSION_HEX >= 0x070600
+    _context->MainSelector()->SetToPrebuildBVH(Standard_True);
+#endif
+
+    // each tick computes sensitive entities for a few milliseconds only
+    _computeTimer.setSingleShot(true);
+    _computeTimer.setInterval(0);
+    connect(&_computeTimer, &QTimer::timeout, this, &occSelectionModes::onComputeTick);
+
+    connect(&_watcher, &QFutureWatcherBase::finished, this, &occSelectionModes::onBuildFinished);
+}
+
+
+occSelectionModes::~occSelectionModes()
+{
+    _computeTimer.stop();
+    _watcher.waitForFinished();
+}
+
+
+void occSelectionModes::setShapeType(TopAbs_ShapeEnum shapeType)
+{
+    if (shapeType == _shapeType)
+        return;
+    _shapeType = shapeType;
+
+    _queue.clear();
+    for (const auto& object : std::as_const(_objects))
+    {
+        _context->Deactivate(object);
+        _queue.append(object);
+    }
+
+    if (!_queue.isEmpty())
+        _computeTimer.start();
+    updateBusy();
+}
+
+
+void occSelectionModes::add(const Handle(AIS_InteractiveObject)& object)
+{
+    if (object.IsNull())
+        return;
+
+    _objects.insert(object.get(), object);
+    _queue.append(object);
+    _computeTimer.start();
+    updateBusy();
+}
+
+
+void occSelectionModes::remove(const Handle(AIS_InteractiveObject)& object)
+{
+    if (_objects.remove(object.get()) == 0)
+        return;
+
+    _queue.removeAll(object);
+    updateBusy();
+}
+
+
+int occSelectionModes::selectionMode(const Handle(AIS_InteractiveObject)& object) const
+{
+    // instances select the sub-shapes of their prototype
+    Handle(AIS_Shape) shape = Handle(AIS_Shape)::DownCast(object);
+    Handle(AIS_ConnectedInteractive) connected = Handle(AIS_ConnectedInteractive)::DownCast(object);
+    if (shape.IsNull() && !connected.IsNull())
+        shape = Handle(AIS_Shape)::DownCast(connected->ConnectedTo());
+
+    if (shape.IsNull())
+        return _shapeType == TopAbs_SHAPE ? 0 : -1;
+
+    return AIS_Shape::SelectionMode(_shapeType);
+}
+
+
+void occSelectionModes::activate(const Handle(AIS_InteractiveObject)& object, int mode)
+{
+    _context->Activate(object, mode);
+}
+
+
+void occSelectionModes::waitForFinished()
+{
+    _computeTimer.stop();
+
+    while (isBusy())
+    {
+        while (!_queue.isEmpty())
+            compute(_queue.takeFirst());
+
+        if (!_isBuilding)
+            startBuild();
+
+        // attaches the selections and starts the next build
+        _watcher.waitForFinished();
+        onBuildFinished();
+    }
+
+    updateBusy();
+}
+
+
+void occSelectionModes::compute(const Handle(AIS_InteractiveObject)& object)
+{
+    const int mode = selectionMode(object);
+    if (mode < 0 || !_context->IsDisplayed(object))
+        return;
+
+    // computed before, e.g. when switching back to a mode
+    if (object->HasSelection(mode))
+    {
+        activate(object, mode);
+        return;
+    }
+
+    // a selection the object does not know yet, so the workers can build its BVH
+    Handle(SelectMgr_Selection) selection = new SelectMgr_Selection(mode);
+    object->ComputeSelection(selection, mode);
+    _computed.append({object, selection});
+}
+
+
+void occSelectionModes::onComputeTick()
+{
+    QElapsedTimer budget;
+    budget.start();
+
+    while (!_queue.isEmpty() && budget.elapsed() < 8)
+        compute(_queue.takeFirst());
+
+    if (!_queue.isEmpty())
+        _computeTimer.start();
+
+    startBuild();
+    updateBusy();
+}
+
+
+void occSelectionModes::startBuild()
+{
+    if (_isBuilding || _computed.isEmpty())
+        return;
+
+    _isBuilding = true;
+    _building.swap(_computed);
+
+    _entities.clear();
+    for (const auto& item : std::as_const(_building))
+    {
+        for (NCollection_Vector<Handle(SelectMgr_SensitiveEntity)>::Iterator it(item.selection->Entities()); it.More(); it.Next())
+            _entities.append(it.Value()->BaseSensitive());
+    }
+
+    _watcher.setFuture(QtConcurrent::map(&_pool, _entities, [](Handle(Select3D_SensitiveEntity)& entity) {
+        entity->BVH();
+    }));
+}
+
+
+void occSelectionModes::onBuildFinished()
+{
+    // already handled by waitForFinished()
+    if (!_isBuilding || _watcher.isRunning())
+        return;
+
+    _isBuilding = false;
+    _entities.clear();
+
+    for (const auto& item : std::as_const(_building))
+    {
+        // computed twice if the mode was switched back and forth in the meantime
+        const int mode = item.selection->Mode();
+        if (item.object->HasSelection(mode))
+            continue;
+
+        // the same state SelectMgr_SelectableObject::RecomputePrimitives() leaves behind,
+        // the selection is kept for later even if the mode changed meanwhile
+        item.object->AddSelection(item.selection, mode);
+        item.selection->UpdateStatus(SelectMgr_TOU_Partial);
+        item.selection->UpdateBVHStatus(SelectMgr_TBU_Add);
+
+        if (_objects.contains(item.object.get()) && mode == selectionMode(item.object)
+                && _context->IsDisplayed(item.object))
+            activate(item.object, mode);
+    }
+    _building.clear();
+
+    startBuild();
+    updateBusy();
+}
+
+
+void occSelectionModes::updateBusy()
+{
+    const bool busy = isBusy();
+    if (busy == _wasBusy)
+        return;
+
+    _wasBusy = busy;
+    emit busyChanged(busy);
+}
@@ -0,0 +1,118 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#ifndef OCCSELECTIONMODES_H
+#define OCCSELECTIONMODES_H
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QThreadPool>
+#include <QTimer>
+
+// occ headers
+#include <AIS_InteractiveContext.hxx>
+#include <SelectMgr_Selection.hxx>
+#include <TopAbs_ShapeEnum.hxx>
+
+/*
+  occSelectionModes activates the selection mode of the displayed objects
+  lazily. Objects are displayed without selection, the sensitive entities
+  of the current mode (whole objects or solids, faces, edges, vertices) are
+  computed in small time slices on the GUI thread, their BVH trees are
+  built on worker threads and the objects are activated once that is done.
+  Switching the mode deactivates the old one and prepares the new one the
+  same way, computed selections are kept for switching back.
+*/
+
+class occSelectionModes : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    // constructor
+    explicit occSelectionModes(const Handle(AIS_InteractiveContext)& context, QObject *parent = nullptr);
+
+    // destructor, waits for the BVH builds
+    ~occSelectionModes();
+
+    // TopAbs_SHAPE selects whole objects, other types the sub-shapes of shapes
+    void setShapeType(TopAbs_ShapeEnum shapeType);
+    TopAbs_ShapeEnum shapeType() const {return _shapeType;}
+
+    // manage a displayed object, or stop managing an erased one
+    void add(const Handle(AIS_InteractiveObject)& object);
+    void remove(const Handle(AIS_InteractiveObject)& object);
+
+    bool isBusy() const {return !_queue.isEmpty() || !_computed.isEmpty() || _isBuilding;}
+
+    // activate everything that is still pending, blocks the GUI thread
+    void waitForFinished();
+
+    // selection mode of the object for the current shape type, -1 if it has none
+    int selectionMode(const Handle(AIS_InteractiveObject)& object) const;
+
+signals:
+    void busyChanged(bool isBusy);
+
+private:
+    struct computedSelection
+    {
+        Handle(AIS_InteractiveObject) object;
+        Handle(SelectMgr_Selection) selection;
+    };
+
+    Handle(AIS_InteractiveContext) _context;
+    TopAbs_ShapeEnum _shapeType {TopAbs_SHAPE};
+
+    QHash<const AIS_InteractiveObject*, Handle(AIS_InteractiveObject)> _objects;
+    QList<Handle(AIS_InteractiveObject)> _queue;
+    QTimer _computeTimer;
+
+    // selections computed but not yet attached, the running batch is only touched by the workers
+    QList<computedSelection> _computed;
+    QList<computedSelection> _building;
+    QList<Handle(Select3D_SensitiveEntity)> _entities;
+    QFutureWatcher<void> _watcher;
+    QThreadPool _pool;
+    bool _isBuilding {false};
+    bool _wasBusy {false};
+
+    void compute(const Handle(AIS_InteractiveObject)& object);
+    void activate(const Handle(AIS_InteractiveObject)& object, int mode);
+    void onComputeTick();
+    void startBuild();
+    void onBuildFinished();
+    void updateBusy();
+};
+
+#endif // OCCSELECTIONMODES_H
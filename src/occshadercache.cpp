@@ -0,0 +1,118 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#include "occshadercache.h"
+
+// Qt headers
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QStandardPaths>
+#include <QTimer>
+#include <QtDebug>
+
+int occShaderCache::_hits {0};
+int occShaderCache::_misses {0};
+
+namespace
+{
+// set an environment variable unless the user set it already
+void setDefault(const char* name, const QByteArray& value)
+{
+    if (!qEnvironmentVariableIsSet(name))
+        qputenv(name, value);
+}
+}
+
+
+void occShaderCache::configure()
+{
+    const QString dir = directory();
+    if (!QDir().mkpath(dir))
+    {
+        qWarning() << "cannot create the shader cache" << dir;
+        return;
+    }
+
+    const QByteArray path = QDir::toNativeSeparators(dir).toLocal8Bit();
+
+    // Mesa, MESA_GLSL_CACHE_* are the names used before Mesa 21
+    setDefault("MESA_SHADER_CACHE_DIR", path);
+    setDefault("MESA_GLSL_CACHE_DIR", path);
+    setDefault("MESA_SHADER_CACHE_MAX_SIZE", "256M");
+
+    // NVIDIA
+    setDefault("__GL_SHADER_DISK_CACHE", "1");
+    setDefault("__GL_SHADER_DISK_CACHE_PATH", path);
+    setDefault("__GL_SHADER_DISK_CACHE_SKIP_CLEANUP", "1");
+}
+
+
+QString occShaderCache::directory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/shaders";
+}
+
+
+void occShaderCache::measure(const QString& name, const std::function<void()>& operation)
+{
+    const int entriesBefore = countEntries();
+
+    QElapsedTimer timer;
+    timer.start();
+    operation();
+    const qint64 msecs = timer.elapsed();
+
+    // New entries mean that the driver had to compile programs it had not seen
+    // before. Drivers write the cache from a background thread, count later.
+    QTimer::singleShot(1000, [name, msecs, entriesBefore] {
+        const int newEntries = countEntries() - entriesBefore;
+        const bool isHit = newEntries <= 0 && entriesBefore > 0;
+        isHit ? ++_hits : ++_misses;
+
+        qInfo().noquote() << QString("shader cache %1: %2 took %3 ms, %4 new entries (hits %5, misses %6)")
+                             .arg(isHit ? "hit" : "miss", name)
+                             .arg(msecs)
+                             .arg(qMax(0, newEntries))
+                             .arg(_hits)
+                             .arg(_misses);
+    });
+}
+
+
+int occShaderCache::countEntries()
+{
+    int count = 0;
+    QDirIterator it(directory(), QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext())
+    {
+        it.next();
+        count++;
+    }
+    return count;
+}
@@ -0,0 +1,69 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#ifndef OCCSHADERCACHE_H
+#define OCCSHADERCACHE_H
+
+// std headers
+#include <functional>
+
+// Qt headers
+#include <QString>
+
+/*
+  occShaderCache keeps compiled GLSL programs across runs. OpenCASCADE 7.5
+  does not store program binaries itself, so the on-disk shader caches of
+  the OpenGL drivers (Mesa and NVIDIA) are pointed at a per-user cache
+  directory of occQt6, unless the user configured them already. measure()
+  times shader heavy operations, such as the first shaded or raytraced
+  frame, and counts them as cache hits or misses depending on whether the
+  driver added new entries to the cache.
+*/
+
+class occShaderCache
+{
+public:
+    // Configure the driver caches, call once before the first OpenGL context is created.
+    static void configure();
+
+    static QString directory();
+
+    // Run a shader heavy operation, its duration and the cache result are logged shortly after.
+    static void measure(const QString& name, const std::function<void()>& operation);
+
+    static int hits() {return _hits;}
+    static int misses() {return _misses;}
+
+private:
+    static int _hits;
+    static int _misses;
+
+    static int countEntries();
+};
+
+#endif // OCCSHADERCACHE_H
@@ -0,0 +1,112 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#include "occstartupprofiler.h"
+
+// std headers
+#include <cstdio>
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QPair>
+#include <QtDebug>
+
+namespace
+{
+struct profilerState
+{
+    profilerState() {clock.start();}
+
+    QElapsedTimer clock;    // started during static initialization, before main()
+    QList<QPair<QString, qint64>> phases;
+    bool isFinished {false};
+};
+
+profilerState& state()
+{
+    static profilerState profiler;
+    return profiler;
+}
+
+// start the clock as early as possible
+[[maybe_unused]] const bool isClockStarted = (state(), true);
+}
+
+
+bool occStartupProfiler::isEnabled()
+{
+    static const bool isEnabled = !qEnvironmentVariableIsEmpty("OCCQT6_STARTUP_PROFILE");
+    return isEnabled;
+}
+
+
+void occStartupProfiler::mark(const QString& phase)
+{
+    if (!isEnabled() || state().isFinished)
+        return;
+
+    state().phases.append({phase, state().clock.nsecsElapsed()});
+}
+
+
+void occStartupProfiler::finish()
+{
+    if (!isEnabled() || state().isFinished)
+        return;
+    state().isFinished = true;
+
+    const auto& phases = state().phases;
+    const QString target = qEnvironmentVariable("OCCQT6_STARTUP_PROFILE");
+
+    if (target == "1")
+    {
+        qint64 previous = 0;
+        for (const auto& phase : phases)
+        {
+            fprintf(stderr, "startup %9.1f ms %+9.1f ms  %s\n",
+                    phase.second / 1.0e6, (phase.second - previous) / 1.0e6, qPrintable(phase.first));
+            previous = phase.second;
+        }
+        return;
+    }
+
+    QJsonArray array;
+    for (const auto& phase : phases)
+        array.append(QJsonObject {{"phase", phase.first}, {"ms", phase.second / 1.0e6}});
+
+    QFile file(target);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        file.write(QJsonDocument(QJsonObject {{"startup", array}}).toJson());
+    else
+        qWarning() << "cannot write startup profile" << target << file.errorString();
+}
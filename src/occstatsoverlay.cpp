@@ -0,0 +1,174 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#include "occstatsoverlay.h"
+
+// std headers
+#include <algorithm>
+#include <cmath>
+
+// occ headers
+#include <Font_FontMgr.hxx>
+#include <Graphic3d_TransformPers.hxx>
+#include <OSD_MemInfo.hxx>
+#include <Prs3d_TextAspect.hxx>
+
+
+occStatsOverlay::occStatsOverlay(const Handle(AIS_InteractiveContext)& context,
+                                 const Handle(V3d_View)& view,
+                                 QObject *parent)
+    : QObject(parent),
+      _context(context),
+      _view(view)
+{
+    // text anchored to the upper right corner, drawn above everything else
+    _label = new AIS_TextLabel();
+    _label->SetColor(Quantity_NOC_WHITE);
+    _label->SetFont(Font_NOF_MONOSPACE);
+    _label->SetHeight(12);
+    _label->SetHJustification(Graphic3d_HTA_RIGHT);
+    _label->SetVJustification(Graphic3d_VTA_TOP);
+    _label->SetZLayer(Graphic3d_ZLayerId_TopOSD);
+    _label->SetTransformPersistence(new Graphic3d_TransformPers(Graphic3d_TMF_2d,
+                                                                Aspect_TOTP_RIGHT_UPPER,
+                                                                Graphic3d_Vec2i(20, 20)));
+    _label->SetInfiniteState(Standard_True);
+
+    _refreshTimer.setInterval(500);
+    connect(&_refreshTimer, &QTimer::timeout, this, &occStatsOverlay::refresh);
+}
+
+
+void occStatsOverlay::setVisible(bool isVisible)
+{
+    if (isVisible == _isVisible)
+        return;
+    _isVisible = isVisible;
+
+    Graphic3d_RenderingParams& params = _view->ChangeRenderingParams();
+    if (_isVisible)
+    {
+        _savedCounters = params.CollectedStats;
+        params.CollectedStats = Graphic3d_RenderingParams::PerfCounters(
+                    Graphic3d_RenderingParams::PerfCounters_Basic
+                    | Graphic3d_RenderingParams::PerfCounters_Triangles
+                    | Graphic3d_RenderingParams::PerfCounters_Points
+                    | Graphic3d_RenderingParams::PerfCounters_EstimMem
+                    | Graphic3d_RenderingParams::PerfCounters_FrameTime);
+        params.ToShowStats = Standard_True;
+
+        _renderTimes.clear();
+        _hoverPickTimes.clear();
+        refresh();
+        // no selection mode, the overlay cannot be picked
+        _context->Display(_label, 0, -1, Standard_False);
+        _refreshTimer.start();
+    }
+    else
+    {
+        _refreshTimer.stop();
+        params.CollectedStats = _savedCounters;
+        params.ToShowStats = Standard_False;
+        _context->Remove(_label, Standard_False);
+    }
+
+    emit changed();
+}
+
+
+void occStatsOverlay::addFrame(double msecs)
+{
+    if (_isVisible)
+        _renderTimes.add(msecs);
+}
+
+
+void occStatsOverlay::addHoverPick(double msecs)
+{
+    if (_isVisible)
+        _hoverPickTimes.add(msecs);
+}
+
+
+void occStatsOverlay::refresh()
+{
+    QString text;
+    if (_renderTimes.count() == 0)
+        text = "render time: no frames yet\n";
+    else
+    {
+        text = QString("render time, last %1 frames\n"
+                       "p50 %2  p95 %3  p99 %4  max %5 ms\n")
+                .arg(_renderTimes.count())
+                .arg(_renderTimes.percentile(50), 0, 'f', 1)
+                .arg(_renderTimes.percentile(95), 0, 'f', 1)
+                .arg(_renderTimes.percentile(99), 0, 'f', 1)
+                .arg(_renderTimes.maximum(), 0, 'f', 1);
+
+        // bins up to the next multiple of 8 ms above p99
+        const int nbBins = 8;
+        const double binWidth = std::max(1.0, std::ceil(_renderTimes.percentile(99) / nbBins));
+        const QVector<int> histogram = _renderTimes.histogram(nbBins, nbBins * binWidth);
+        const int maxCount = *std::max_element(histogram.cbegin(), histogram.cend());
+        for (int bin = 0; bin < nbBins; bin++)
+        {
+            const int barLength = maxCount > 0 ? (30 * histogram.at(bin) + maxCount - 1) / maxCount : 0;
+            text += QString("%1-%2 ms %3 %4\n")
+                    .arg(bin * binWidth, 3, 'f', 0)
+                    .arg(bin == nbBins - 1 ? QString("   ") : QString("%1").arg((bin + 1) * binWidth, 3, 'f', 0))
+                    .arg(QString(barLength, '#'), -30)
+                    .arg(histogram.at(bin), 5);
+        }
+    }
+
+    if (_hoverPickTimes.count() > 0)
+        text += QString("hover picks, last %1: p50 %2  p95 %3 ms\n")
+                .arg(_hoverPickTimes.count())
+                .arg(_hoverPickTimes.percentile(50), 0, 'f', 1)
+                .arg(_hoverPickTimes.percentile(95), 0, 'f', 1);
+
+    OSD_MemInfo memInfo;
+    auto megabytes = [&memInfo](OSD_MemInfo::Counter counter) {
+        const Standard_Size value = memInfo.Value(counter);
+        return value == Standard_Size(-1) ? QString("n/a") : QString::number(value / (1024.0 * 1024.0), 'f', 0);
+    };
+    text += QString("memory: %1 MiB private, %2 MiB working set\n")
+            .arg(megabytes(OSD_MemInfo::MemPrivate), megabytes(OSD_MemInfo::MemWorkingSet));
+
+    // without the overlay itself
+    AIS_ListOfInteractive objects;
+    _context->DisplayedObjects(objects);
+    const int nbObjects = objects.Size() - (_context->IsDisplayed(_label) ? 1 : 0);
+    text += QString("objects: %1 displayed").arg(nbObjects);
+
+    _label->SetText(TCollection_ExtendedString(text.toUtf8().constData(), Standard_True));
+    if (_context->IsDisplayed(_label))
+        _context->Redisplay(_label, Standard_False);
+
+    emit changed();
+}
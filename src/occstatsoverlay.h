@@ -0,0 +1,90 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#ifndef OCCSTATSOVERLAY_H
+#define OCCSTATSOVERLAY_H
+
+// Qt headers
+#include <QObject>
+#include <QTimer>
+
+// occ headers
+#include <AIS_InteractiveContext.hxx>
+#include <AIS_TextLabel.hxx>
+#include <Graphic3d_RenderingParams.hxx>
+#include <V3d_View.hxx>
+
+// project headers
+#include "occframestats.h"
+
+/*
+  occStatsOverlay shows rendering statistics on top of the view: the frame
+  statistics of OpenCASCADE (frame rate, structures, triangles, GPU memory)
+  and histograms with percentiles of the render times measured by the
+  view and of the hover picking times, together with the memory used by
+  the process. The overlay text is refreshed twice per second.
+*/
+
+class occStatsOverlay : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    // constructor
+    explicit occStatsOverlay(const Handle(AIS_InteractiveContext)& context,
+                             const Handle(V3d_View)& view,
+                             QObject *parent = nullptr);
+
+    void setVisible(bool isVisible);
+    bool isVisible() const {return _isVisible;}
+
+    // render time of a frame
+    void addFrame(double msecs);
+
+    // time spent picking the object under the mouse
+    void addHoverPick(double msecs);
+
+signals:
+    // the overlay changed and the view needs to be redrawn
+    void changed();
+
+private:
+    Handle(AIS_InteractiveContext) _context;
+    Handle(V3d_View) _view;
+    Handle(AIS_TextLabel) _label;
+    QTimer _refreshTimer;
+    occFrameStats _renderTimes {500};
+    occFrameStats _hoverPickTimes {500};
+    bool _isVisible {false};
+    Graphic3d_RenderingParams::PerfCounters _savedCounters {Graphic3d_RenderingParams::PerfCounters_NONE};
+
+    void refresh();
+};
+
+#endif // OCCSTATSOVERLAY_H
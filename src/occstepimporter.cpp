@@ -0,0 +1,295 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#include "occstepimporter.h"
+
+// std headers
+#include <numeric>
+#include <utility>
+
+// Qt headers
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtConcurrent/QtConcurrentRun>
+
+// occ headers
+#include <IFSelect_ReturnStatus.hxx>
+#include <NCollection_DataMap.hxx>
+#include <STEPCAFControl_Reader.hxx>
+#include <STEPControl_Reader.hxx>
+#include <TDF_LabelMapHasher.hxx>
+#include <TDocStd_Document.hxx>
+#include <XCAFApp_Application.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
+#include <XCAFPrs_DocumentExplorer.hxx>
+
+// project headers
+#include "occmesher.h"
+
+
+QString occStepImportReport::toString() const
+{
+    if (!error.isEmpty())
+        return error;
+
+    return QString("%1 parts, %2 shapes%3, parse %4 ms, transfer %5 ms, mesh %6 ms, display %7 ms")
+            .arg(nbParts)
+            .arg(nbInstances)
+            .arg(isCancelled ? QString(" (cancelled)") : QString())
+            .arg(parseMsecs)
+            .arg(transferMsecs)
+            .arg(meshMsecs)
+            .arg(displayMsecs);
+}
+
+
+occStepImporter::occStepImporter(const occMesher* mesher, QObject *parent)
+    : QObject(parent),
+      _mesher(mesher)
+{
+    _displayTimer.setSingleShot(true);
+    _displayTimer.setInterval(100);
+    connect(&_displayTimer, &QTimer::timeout, this, &occStepImporter::flush);
+
+    connect(&_readWatcher, &QFutureWatcherBase::finished, this, &occStepImporter::onRead);
+    connect(&_meshWatcher, &QFutureWatcherBase::resultReadyAt, this, &occStepImporter::onPartMeshed);
+    connect(&_meshWatcher, &QFutureWatcherBase::finished, this, &occStepImporter::onMeshed);
+}
+
+
+occStepImporter::~occStepImporter()
+{
+    cancel();
+    _readWatcher.waitForFinished();
+    _meshWatcher.waitForFinished();
+}
+
+
+bool occStepImporter::start(const QString& fileName)
+{
+    if (_isBusy)
+        return false;
+
+    _isBusy = true;
+    _report = occStepImportReport();
+    _report.fileName = fileName;
+
+    // the transfer is the first half of the progress, meshing the second
+    _indicator = new occProgressIndicator();
+    _indicator->setProgressCallback([this](int percent) {
+        QMetaObject::invokeMethod(this, [this, percent] { emit progress(percent / 2); }, Qt::QueuedConnection);
+    });
+
+    const Handle(occProgressIndicator) indicator = _indicator;
+    _readWatcher.setFuture(QtConcurrent::run(&_pool, [fileName, indicator] {
+        return read(fileName, indicator);
+    }));
+    return true;
+}
+
+
+void occStepImporter::cancel()
+{
+    if (!_isBusy)
+        return;
+
+    _indicator->cancel();
+    _meshWatcher.cancel();
+}
+
+
+TopoDS_Shape occStepImporter::readShape(const QString& fileName, QString* error)
+{
+    STEPControl_Reader reader;
+    if (reader.ReadFile(fileName.toUtf8().constData()) != IFSelect_RetDone)
+    {
+        if (error)
+            *error = QString("cannot read %1").arg(fileName);
+        return TopoDS_Shape();
+    }
+
+    reader.TransferRoots();
+    TopoDS_Shape shape = reader.OneShape();
+    if (shape.IsNull() && error)
+        *error = QString("no shapes in %1").arg(fileName);
+    return shape;
+}
+
+
+occStepImporter::document occStepImporter::read(const QString& fileName, const Handle(occProgressIndicator)& indicator)
+{
+    document result;
+    QElapsedTimer timer;
+    timer.start();
+
+    STEPCAFControl_Reader reader;
+    reader.SetColorMode(Standard_True);
+    reader.SetNameMode(Standard_True);
+    reader.SetLayerMode(Standard_False);
+    if (reader.ReadFile(fileName.toUtf8().constData()) != IFSelect_RetDone)
+    {
+        result.error = QString("cannot read %1").arg(fileName);
+        return result;
+    }
+    result.parseMsecs = timer.restart();
+
+    if (indicator->isCancelled())
+        return result;
+
+    Handle(TDocStd_Document) doc;
+    Handle(XCAFApp_Application) application = XCAFApp_Application::GetApplication();
+    application->NewDocument("MDTV-XCAF", doc);
+    if (!reader.Transfer(doc, indicator->Start()))
+    {
+        if (!indicator->isCancelled())
+            result.error = QString("cannot transfer %1").arg(fileName);
+        application->Close(doc);
+        return result;
+    }
+    result.transferMsecs = timer.elapsed();
+
+    // leaf parts with their location in the assembly, parts used several times are meshed once
+    const Quantity_Color defaultColor(0.7, 0.7, 0.7, Quantity_TOC_sRGB);
+    NCollection_DataMap<TDF_Label, int, TDF_LabelMapHasher> partOfLabel;
+    for (XCAFPrs_DocumentExplorer explorer(doc, XCAFPrs_DocumentExplorerFlags_OnlyLeafNodes); explorer.More(); explorer.Next())
+    {
+        const XCAFPrs_DocumentNode& node = explorer.Current();
+
+        int part = -1;
+        if (!partOfLabel.Find(node.RefLabel, part))
+        {
+            const TopoDS_Shape shape = XCAFDoc_ShapeTool::GetShape(node.RefLabel);
+            if (shape.IsNull())
+                continue;
+
+            part = result.parts.size();
+            result.parts.append(shape);
+            partOfLabel.Bind(node.RefLabel, part);
+        }
+
+        const Quantity_Color color = node.Style.IsSetColorSurf() ? node.Style.GetColorSurf() : defaultColor;
+        result.instances.append({result.parts.at(part).Moved(node.Location), color, part});
+    }
+
+    application->Close(doc);
+    return result;
+}
+
+
+void occStepImporter::onRead()
+{
+    _document = _readWatcher.result();
+    _report.parseMsecs = _document.parseMsecs;
+    _report.transferMsecs = _document.transferMsecs;
+    _report.error = _document.error;
+
+    if (!_report.error.isEmpty() || _indicator->isCancelled())
+    {
+        finish();
+        return;
+    }
+
+    const int nbParts = _document.parts.size();
+    _report.nbParts = nbParts;
+    _report.nbInstances = _document.instances.size();
+
+    _instancesOfPart = QVector<QVector<int>>(nbParts);
+    for (int i = 0; i < _document.instances.size(); i++)
+        _instancesOfPart[_document.instances.at(i).part].append(i);
+
+    _partIndices.resize(nbParts);
+    std::iota(_partIndices.begin(), _partIndices.end(), 0);
+    _nbMeshed = 0;
+    _meshClock.start();
+
+    // every part in its own task, BRepMesh runs in parallel inside large parts as well
+    const QVector<TopoDS_Shape> parts = _document.parts;
+    const Handle(occProgressIndicator) indicator = _indicator;
+    _meshWatcher.setFuture(QtConcurrent::mapped(&_pool, _partIndices, [this, parts, indicator](int index) {
+        if (!indicator->isCancelled())
+            _mesher->meshShape(parts.at(index));
+
+        const int percent = 50 + 50 * ++_nbMeshed / parts.size();
+        QMetaObject::invokeMethod(this, [this, percent] { emit progress(percent); }, Qt::QueuedConnection);
+        return index;
+    }));
+}
+
+
+void occStepImporter::onPartMeshed(int index)
+{
+    if (_indicator->isCancelled())
+        return;
+
+    const int part = _meshWatcher.resultAt(index);
+    for (const int i : _instancesOfPart.at(part))
+    {
+        const instance& item = _document.instances.at(i);
+        _ready.append({new AIS_Shape(item.shape), item.color});
+    }
+
+    if (!_displayTimer.isActive())
+        _displayTimer.start();
+}
+
+
+void occStepImporter::onMeshed()
+{
+    _report.meshMsecs = _meshClock.elapsed();
+
+    _displayTimer.stop();
+    flush();
+    finish();
+}
+
+
+void occStepImporter::flush()
+{
+    if (_ready.isEmpty())
+        return;
+
+    const occStepPartList parts = std::exchange(_ready, occStepPartList());
+
+    QElapsedTimer timer;
+    timer.start();
+    emit partsReady(parts);
+    _report.displayMsecs += timer.elapsed();
+}
+
+
+void occStepImporter::finish()
+{
+    _report.isCancelled = _indicator->isCancelled();
+    _isBusy = false;
+
+    _document = document();
+    _instancesOfPart.clear();
+    _partIndices.clear();
+    _ready.clear();
+
+    emit finished(_report);
+}
@@ -0,0 +1,164 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#ifndef OCCSTEPIMPORTER_H
+#define OCCSTEPIMPORTER_H
+
+// std headers
+#include <atomic>
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVector>
+
+// occ headers
+#include <AIS_Shape.hxx>
+#include <Quantity_Color.hxx>
+#include <TopoDS_Shape.hxx>
+
+// project headers
+#include "occprogressindicator.h"
+
+class occMesher;
+
+// a part instance of an imported assembly, ready to be displayed
+struct occStepPart
+{
+    Handle(AIS_Shape) shape;
+    Quantity_Color color;
+};
+
+using occStepPartList = QList<occStepPart>;
+
+struct occStepImportReport
+{
+    QString fileName;
+    int nbParts {0};            // distinct parts, each meshed once
+    int nbInstances {0};        // displayed shapes
+    qint64 parseMsecs {0};
+    qint64 transferMsecs {0};
+    qint64 meshMsecs {0};
+    qint64 displayMsecs {0};
+    bool isCancelled {false};
+    QString error;
+
+    QString toString() const;
+};
+
+/*
+  occStepImporter reads STEP files with STEPCAFControl_Reader into an XCAF
+  document. Parsing and the transfer into the document run on a worker
+  thread; the transfer itself is sequential, one reader cannot transfer
+  roots concurrently. The leaf parts found by XCAFPrs_DocumentExplorer are
+  meshed in parallel, every distinct part once, and handed out through
+  partsReady() as soon as their mesh is done, so large assemblies appear
+  piece by piece. The time of every stage is collected in the report.
+*/
+
+class occStepImporter : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    // constructor
+    explicit occStepImporter(const occMesher* mesher, QObject *parent = nullptr);
+
+    // destructor, cancels and waits for the workers
+    ~occStepImporter();
+
+    // Start importing, returns false if an import is already running.
+    bool start(const QString& fileName);
+    bool isBusy() const {return _isBusy;}
+
+    // Read the file and return all parts as one compound, used without viewer
+    static TopoDS_Shape readShape(const QString& fileName, QString* error = nullptr);
+
+public slots:
+    void cancel();
+
+signals:
+    void progress(int percent);
+
+    // Parts to display, emitted from the GUI thread while meshing continues.
+    // Connect directly, the time spent in the slots is reported as display time.
+    void partsReady(const occStepPartList& parts);
+    void finished(const occStepImportReport& report);
+
+private:
+    struct instance
+    {
+        TopoDS_Shape shape;     // located part shape
+        Quantity_Color color;
+        int part;
+    };
+
+    struct document
+    {
+        QVector<TopoDS_Shape> parts;
+        QVector<instance> instances;
+        qint64 parseMsecs {0};
+        qint64 transferMsecs {0};
+        QString error;
+    };
+
+    const occMesher* _mesher;
+    QThreadPool _pool;
+
+    bool _isBusy {false};
+    occStepImportReport _report;
+    Handle(occProgressIndicator) _indicator;
+
+    QFutureWatcher<document> _readWatcher;
+    QFutureWatcher<int> _meshWatcher;
+    document _document;
+    QVector<int> _partIndices;
+    QVector<QVector<int>> _instancesOfPart;
+    QElapsedTimer _meshClock;
+    std::atomic_int _nbMeshed {0};
+
+    // meshed parts are displayed in batches, at most 10 times per second
+    QTimer _displayTimer;
+    occStepPartList _ready;
+
+    static document read(const QString& fileName, const Handle(occProgressIndicator)& indicator);
+
+    void onRead();
+    void onPartMeshed(int index);
+    void onMeshed();
+    void flush();
+    void finish();
+};
+
+#endif // OCCSTEPIMPORTER_H
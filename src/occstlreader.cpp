@@ -0,0 +1,434 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#include "occstlreader.h"
+
+// std headers
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QFile>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtConcurrent/QtConcurrentRun>
+
+// occ headers
+#include <Poly.hxx>
+#include <RWStl.hxx>
+#include <Standard_Version.hxx>
+
+
+namespace
+{
+const qint64 headerSize {84};
+const qint64 facetSize {50};                // normal, three vertices and a 16 bit attribute
+const qint64 vertexOffset {12};             // the facet normal is recomputed, not read
+const int chunkSize {1 << 16};              // triangles per task
+const int partitionBits {8};
+const int nbPartitions {1 << partitionBits};
+
+struct vertexKey
+{
+    quint32 x;
+    quint32 y;
+    quint32 z;
+
+    bool operator==(const vertexKey& other) const {return x == other.x && y == other.y && z == other.z;}
+};
+
+quint32 floatBits(const uchar* data)
+{
+    float value;
+    std::memcpy(&value, data, sizeof(value));
+    if (value == 0.0f)
+        value = 0.0f;   // -0 and +0 are the same coordinate
+
+    quint32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// corner is 3 * triangle + vertex of the triangle
+const uchar* cornerData(const uchar* facets, quint32 corner)
+{
+    return facets + qint64(corner / 3) * facetSize + vertexOffset + 12 * (corner % 3);
+}
+
+vertexKey cornerKey(const uchar* facets, quint32 corner)
+{
+    const uchar* data = cornerData(facets, corner);
+    return {floatBits(data), floatBits(data + 4), floatBits(data + 8)};
+}
+
+gp_Pnt cornerPoint(const uchar* facets, quint32 corner)
+{
+    float xyz[3];
+    std::memcpy(xyz, cornerData(facets, corner), sizeof(xyz));
+    return gp_Pnt(xyz[0], xyz[1], xyz[2]);
+}
+
+quint32 hashKey(const vertexKey& key)
+{
+    quint64 hash = quint64(key.x) * 0x9E3779B97F4A7C15ull;
+    hash ^= quint64(key.y) * 0xC2B2AE3D27D4EB4Full;
+    hash ^= quint64(key.z) * 0x165667B19E3779F9ull;
+    hash ^= hash >> 29;
+    hash *= 0xBF58476D1CE4E5B9ull;
+    hash ^= hash >> 32;
+    return quint32(hash);
+}
+
+// the partition uses the high bits of the hash, the hash tables the low ones
+int partitionOf(quint32 hash)
+{
+    return int(hash >> (32 - partitionBits));
+}
+
+Handle(Poly_Triangulation) readAscii(const QString& fileName, occStlReport& report)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    Handle(Poly_Triangulation) triangulation = RWStl::ReadFile(fileName.toUtf8().constData());
+    report.isBinary = false;
+    report.decodeMsecs = timer.elapsed();
+    if (triangulation.IsNull())
+    {
+        report.error = QString("cannot read %1").arg(fileName);
+        return triangulation;
+    }
+
+    report.nbTriangles = triangulation->NbTriangles();
+    report.nbNodes = triangulation->NbNodes();
+    return triangulation;
+}
+}
+
+
+QString occStlReport::toString() const
+{
+    if (!error.isEmpty())
+        return error;
+
+    if (!isBinary)
+        return QString("%1 triangles, %2 nodes, ASCII read %3 ms").arg(nbTriangles).arg(nbNodes).arg(decodeMsecs);
+
+    return QString("%1 triangles, %2 nodes, %3 MB%4, decode %5 ms, merge %6 ms, build %7 ms, total %8 ms")
+            .arg(nbTriangles)
+            .arg(nbNodes)
+            .arg(fileBytes / (1024 * 1024))
+            .arg(isCancelled ? QString(" (cancelled)") : QString())
+            .arg(decodeMsecs)
+            .arg(mergeMsecs)
+            .arg(buildMsecs)
+            .arg(totalMsecs);
+}
+
+
+occStlReader::occStlReader(QObject *parent)
+    : QObject(parent)
+{
+    // the reader itself runs in one task, it spreads its chunks over the global pool
+    _pool.setMaxThreadCount(1);
+    connect(&_watcher, &QFutureWatcherBase::finished, this, &occStlReader::onFinished);
+}
+
+
+occStlReader::~occStlReader()
+{
+    cancel();
+    _watcher.waitForFinished();
+}
+
+
+bool occStlReader::start(const QString& fileName)
+{
+    if (_watcher.isRunning())
+        return false;
+
+    _isCancelled = false;
+    _watcher.setFuture(QtConcurrent::run(&_pool, [this, fileName] {
+        result item;
+        item.triangulation = read(fileName, item.report, _isCancelled, [this](int percent) {
+            QMetaObject::invokeMethod(this, [this, percent] { emit progress(percent); }, Qt::QueuedConnection);
+        });
+        return item;
+    }));
+    return true;
+}
+
+
+Handle(Poly_Triangulation) occStlReader::read(const QString& fileName, occStlReport& report,
+                                              const std::atomic_bool& isCancelled,
+                                              const std::function<void(int)>& progress)
+{
+    report = occStlReport();
+    report.fileName = fileName;
+
+    QElapsedTimer total;
+    total.start();
+    QElapsedTimer timer;
+    timer.start();
+
+    auto setProgress = [&progress](int percent) {
+        if (progress)
+            progress(percent);
+    };
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        report.error = QString("cannot open %1").arg(fileName);
+        return nullptr;
+    }
+    report.fileBytes = file.size();
+
+    quint32 nbTriangles = 0;
+    if (report.fileBytes >= headerSize)
+    {
+        file.seek(headerSize - 4);
+        uchar count[4];
+        if (file.read(reinterpret_cast<char*>(count), 4) == 4)
+            nbTriangles = count[0] | count[1] << 8 | count[2] << 16 | quint32(count[3]) << 24;
+    }
+
+    // an ASCII file starts with "solid" as well, only the size tells them apart
+    if (report.fileBytes < headerSize || report.fileBytes != headerSize + facetSize * qint64(nbTriangles))
+    {
+        file.seek(0);
+        if (file.read(5) != "solid")
+        {
+            report.error = QString("%1 is not an STL file").arg(fileName);
+            return nullptr;
+        }
+        file.close();
+        return readAscii(fileName, report);
+    }
+
+    if (nbTriangles == 0 || qint64(nbTriangles) * 3 > std::numeric_limits<int>::max())
+    {
+        report.error = nbTriangles == 0 ? QString("no triangles in %1").arg(fileName)
+                                        : QString("too many triangles in %1").arg(fileName);
+        return nullptr;
+    }
+    report.nbTriangles = nbTriangles;
+
+    const uchar* data = file.map(0, report.fileBytes);
+    if (!data)
+    {
+        report.error = QString("cannot map %1").arg(fileName);
+        return nullptr;
+    }
+    const uchar* facets = data + headerSize;
+
+    const int nbChunks = int((qint64(nbTriangles) + chunkSize - 1) / chunkSize);
+    QVector<int> chunks(nbChunks);
+    std::iota(chunks.begin(), chunks.end(), 0);
+
+    QVector<int> partitions(nbPartitions);
+    std::iota(partitions.begin(), partitions.end(), 0);
+
+    auto forEachCorner = [nbTriangles](int chunk, const auto& function) {
+        const quint32 first = quint32(chunk) * chunkSize * 3;
+        const quint32 last = qMin(quint32(chunk + 1) * chunkSize, nbTriangles) * 3;
+        for (quint32 corner = first; corner < last; corner++)
+            function(corner);
+    };
+
+    QThreadPool* pool = QThreadPool::globalInstance();
+
+    // 1. count the corners of every chunk per partition
+    std::vector<quint32> offsets(size_t(nbChunks) * nbPartitions, 0);
+    QtConcurrent::blockingMap(pool, chunks, [&](int chunk) {
+        quint32* count = offsets.data() + size_t(chunk) * nbPartitions;
+        forEachCorner(chunk, [&](quint32 corner) {
+            count[partitionOf(hashKey(cornerKey(facets, corner)))]++;
+        });
+    });
+    setProgress(15);
+
+    // the corners of a partition are contiguous, the chunks write behind each other
+    std::vector<quint32> partitionStart(nbPartitions + 1, 0);
+    for (int partition = 0; partition < nbPartitions; partition++)
+    {
+        quint32 start = partitionStart[partition];
+        for (int chunk = 0; chunk < nbChunks; chunk++)
+        {
+            quint32& count = offsets[size_t(chunk) * nbPartitions + partition];
+            const quint32 nb = count;
+            count = start;
+            start += nb;
+        }
+        partitionStart[partition + 1] = start;
+    }
+
+    if (isCancelled)
+    {
+        report.isCancelled = true;
+        return nullptr;
+    }
+
+    // 2. sort the corners by partition
+    std::vector<quint32> corners(size_t(nbTriangles) * 3);
+    QtConcurrent::blockingMap(pool, chunks, [&](int chunk) {
+        quint32* cursor = offsets.data() + size_t(chunk) * nbPartitions;
+        forEachCorner(chunk, [&](quint32 corner) {
+            corners[cursor[partitionOf(hashKey(cornerKey(facets, corner)))]++] = corner;
+        });
+    });
+    offsets = std::vector<quint32>();
+    report.decodeMsecs = timer.restart();
+    setProgress(35);
+
+    if (isCancelled)
+    {
+        report.isCancelled = true;
+        return nullptr;
+    }
+
+    // 3. merge the equal vertices of every partition, a corner gets the index of its vertex in the partition
+    std::vector<quint32> vertexOfCorner(size_t(nbTriangles) * 3);
+    std::vector<std::vector<quint32>> firstCorners(nbPartitions);
+    QtConcurrent::blockingMap(pool, partitions, [&](int partition) {
+        const quint32 first = partitionStart[partition];
+        const quint32 last = partitionStart[partition + 1];
+        if (first == last || isCancelled)
+            return;
+
+        // open addressing with linear probing, at most half full
+        quint32 capacity = 16;
+        while (capacity < 2 * (last - first))
+            capacity *= 2;
+        const quint32 mask = capacity - 1;
+        const quint32 empty = std::numeric_limits<quint32>::max();
+
+        struct slot
+        {
+            vertexKey key;
+            quint32 vertex;
+        };
+        std::vector<slot> table(capacity, slot {{0, 0, 0}, empty});
+
+        std::vector<quint32>& vertices = firstCorners[partition];
+        for (quint32 i = first; i < last; i++)
+        {
+            const quint32 corner = corners[i];
+            const vertexKey key = cornerKey(facets, corner);
+            quint32 index = hashKey(key) & mask;
+            while (table[index].vertex != empty && !(table[index].key == key))
+                index = (index + 1) & mask;
+
+            if (table[index].vertex == empty)
+            {
+                table[index] = {key, quint32(vertices.size())};
+                vertices.push_back(corner);
+            }
+            vertexOfCorner[corner] = table[index].vertex;
+        }
+    });
+
+    if (isCancelled)
+    {
+        report.isCancelled = true;
+        return nullptr;
+    }
+
+    // the nodes of a partition are contiguous, turn the partition indices into node indices
+    std::vector<quint32> firstNode(nbPartitions + 1, 0);
+    for (int partition = 0; partition < nbPartitions; partition++)
+        firstNode[partition + 1] = firstNode[partition] + quint32(firstCorners[partition].size());
+
+    QtConcurrent::blockingMap(pool, partitions, [&](int partition) {
+        for (quint32 i = partitionStart[partition]; i < partitionStart[partition + 1]; i++)
+            vertexOfCorner[corners[i]] += firstNode[partition] + 1;
+    });
+    corners = std::vector<quint32>();
+    report.nbNodes = firstNode[nbPartitions];
+    report.mergeMsecs = timer.restart();
+    setProgress(60);
+
+    if (isCancelled)
+    {
+        report.isCancelled = true;
+        return nullptr;
+    }
+
+    // 4. fill the triangulation, every task writes its own nodes and triangles
+    Handle(Poly_Triangulation) triangulation = new Poly_Triangulation(int(report.nbNodes), int(nbTriangles), Standard_False);
+
+    QtConcurrent::blockingMap(pool, partitions, [&](int partition) {
+        int node = int(firstNode[partition]) + 1;
+        for (const quint32 corner : firstCorners[partition])
+        {
+#if OCC_VERSION_HEX >= 0x070600
+            triangulation->SetNode(node++, cornerPoint(facets, corner));
+#else
+            triangulation->ChangeNodes().SetValue(node++, cornerPoint(facets, corner));
+#endif
+        }
+        firstCorners[partition] = std::vector<quint32>();
+    });
+
+    QtConcurrent::blockingMap(pool, chunks, [&](int chunk) {
+        const quint32 first = quint32(chunk) * chunkSize;
+        const quint32 last = qMin(quint32(chunk + 1) * chunkSize, nbTriangles);
+        for (quint32 i = first; i < last; i++)
+        {
+            const Poly_Triangle triangle(int(vertexOfCorner[3 * i]), int(vertexOfCorner[3 * i + 1]), int(vertexOfCorner[3 * i + 2]));
+#if OCC_VERSION_HEX >= 0x070600
+            triangulation->SetTriangle(int(i) + 1, triangle);
+#else
+            triangulation->ChangeTriangles().SetValue(int(i) + 1, triangle);
+#endif
+        }
+    });
+    vertexOfCorner = std::vector<quint32>();
+    file.unmap(const_cast<uchar*>(data));
+    setProgress(80);
+
+    // smooth shading needs vertex normals
+#if OCC_VERSION_HEX >= 0x070600
+    triangulation->ComputeNormals();
+#else
+    Poly::ComputeNormals(triangulation);
+#endif
+    report.buildMsecs = timer.elapsed();
+    report.totalMsecs = total.elapsed();
+    setProgress(100);
+    return triangulation;
+}
+
+
+void occStlReader::onFinished()
+{
+    const result item = _watcher.result();
+    emit finished(item.triangulation, item.report);
+}
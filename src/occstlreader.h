@@ -0,0 +1,114 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#ifndef OCCSTLREADER_H
+#define OCCSTLREADER_H
+
+// std headers
+#include <atomic>
+#include <functional>
+
+// Qt headers
+#include <QFutureWatcher>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+
+// occ headers
+#include <Poly_Triangulation.hxx>
+
+struct occStlReport
+{
+    QString fileName;
+    qint64 fileBytes {0};
+    qint64 nbTriangles {0};
+    qint64 nbNodes {0};         // after merging equal vertices
+    bool isBinary {true};
+    qint64 decodeMsecs {0};     // counting and sorting the vertices by hash
+    qint64 mergeMsecs {0};      // merging equal vertices
+    qint64 buildMsecs {0};      // nodes, triangles and normals of the triangulation
+    qint64 totalMsecs {0};
+    bool isCancelled {false};
+    QString error;
+
+    QString toString() const;
+};
+
+/*
+  occStlReader loads binary STL files of tens of millions of triangles into
+  a single Poly_Triangulation, without topology. The file is memory mapped
+  and read in chunks by all cores: the vertices are first sorted into
+  partitions by their hash, then every partition merges its equal vertices
+  with its own hash table, so no locks are needed. Apart from the mapped
+  file the reader needs 24 bytes per triangle while it runs. ASCII files
+  are handed to RWStl.
+*/
+
+class occStlReader : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    // constructor
+    explicit occStlReader(QObject *parent = nullptr);
+
+    // destructor, cancels and waits for the reader
+    ~occStlReader();
+
+    // Read the file on a worker thread, returns false if a file is still being read.
+    bool start(const QString& fileName);
+    bool isBusy() const {return _watcher.isRunning();}
+
+    // Read the file on the calling thread, the progress is reported in percent.
+    static Handle(Poly_Triangulation) read(const QString& fileName, occStlReport& report,
+                                           const std::atomic_bool& isCancelled,
+                                           const std::function<void(int)>& progress = nullptr);
+
+public slots:
+    void cancel() {_isCancelled = true;}
+
+signals:
+    void progress(int percent);
+    void finished(const Handle(Poly_Triangulation)& triangulation, const occStlReport& report);
+
+private:
+    struct result
+    {
+        Handle(Poly_Triangulation) triangulation;
+        occStlReport report;
+    };
+
+    QThreadPool _pool;
+    QFutureWatcher<result> _watcher;
+    std::atomic_bool _isCancelled {false};
+
+    void onFinished();
+};
+
+#endif // OCCSTLREADER_H
@@ -0,0 +1,97 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#include "occstyleregistry.h"
+
+// occ headers
+#include <Prs3d_LineAspect.hxx>
+#include <Prs3d_PointAspect.hxx>
+#include <Prs3d_ShadingAspect.hxx>
+
+namespace
+{
+QString colorKey(const Quantity_Color& color)
+{
+    return QString::fromLatin1(Quantity_Color::ColorToHex(color).ToCString());
+}
+}
+
+
+Handle(Prs3d_Drawer) occStyleRegistry::drawer(const Quantity_Color& color, const occEdgeStyle& edges)
+{
+    const QString key = QString("%1|%2|%3|%4")
+            .arg(colorKey(color), colorKey(edges.color))
+            .arg(edges.width)
+            .arg(edges.isVisible);
+
+    auto it = _drawers.constFind(key);
+    if (it != _drawers.constEnd())
+        return it.value();
+
+    // the same aspects AIS_Shape::SetColor() would create, but only once per style
+    Handle(occSharedDrawer) drawer = new occSharedDrawer();
+    drawer->Link(_defaultDrawer);
+
+    drawer->SetupOwnShadingAspect(_defaultDrawer);
+    drawer->ShadingAspect()->SetColor(color);
+
+    drawer->SetOwnLineAspects(_defaultDrawer);
+    drawer->LineAspect()->SetColor(color);
+    drawer->WireAspect()->SetColor(color);
+    drawer->FreeBoundaryAspect()->SetColor(color);
+    drawer->UnFreeBoundaryAspect()->SetColor(color);
+    drawer->SeenLineAspect()->SetColor(color);
+
+    drawer->SetupOwnPointAspect(_defaultDrawer);
+    drawer->PointAspect()->SetColor(color);
+
+    drawer->SetFaceBoundaryDraw(edges.isVisible);
+    drawer->SetFaceBoundaryAspect(new Prs3d_LineAspect(edges.color, Aspect_TOL_SOLID, edges.width));
+
+    _drawers.insert(key, drawer);
+    return drawer;
+}
+
+
+void occStyleRegistry::apply(const Handle(AIS_InteractiveObject)& object, const Quantity_Color& color,
+                             const occEdgeStyle& edges)
+{
+    object->SetAttributes(drawer(color, edges));
+}
+
+
+void occStyleRegistry::detach(const Handle(AIS_InteractiveObject)& object)
+{
+    Handle(Prs3d_Drawer) shared = Handle(occSharedDrawer)::DownCast(object->Attributes());
+    if (shared.IsNull())
+        return;
+
+    Handle(Prs3d_Drawer) own = new Prs3d_Drawer();
+    own->Link(shared);
+    object->SetAttributes(own);
+}
@@ -0,0 +1,94 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#ifndef OCCSTYLEREGISTRY_H
+#define OCCSTYLEREGISTRY_H
+
+// Qt headers
+#include <QHash>
+#include <QString>
+
+// occ headers
+#include <AIS_InteractiveObject.hxx>
+#include <Prs3d_Drawer.hxx>
+#include <Quantity_Color.hxx>
+
+// style of the face boundaries drawn on shaded shapes
+struct occEdgeStyle
+{
+    Quantity_Color color {Quantity_NOC_BLACK};
+    double width {2.0};
+    bool isVisible {true};
+};
+
+// drawer handed out by occStyleRegistry, the type marks it as shared
+class occSharedDrawer : public Prs3d_Drawer
+{
+    DEFINE_STANDARD_RTTI_INLINE(occSharedDrawer, Prs3d_Drawer)
+};
+
+/*
+  occStyleRegistry hands out shared Prs3d_Drawer objects, one per face
+  color and edge style, instead of giving every shape its own drawer and
+  aspects. Thousands of shapes then reference a handful of aspects, which
+  saves memory and lets the renderer skip state changes between shapes of
+  the same style.
+
+  A shared drawer must not be modified through a single shape. The display
+  mode, color, transparency, material and width setters of AIS_Shape and
+  AIS_InteractiveContext all write into the drawer and would restyle every
+  shape of that style. Use the occView setters instead, which detach the
+  shape first, or call detach() before changing an object directly.
+*/
+
+class occStyleRegistry
+{
+public:
+
+    // the drawer the shared styles inherit from, usually the default drawer of the context
+    void setDefaultDrawer(const Handle(Prs3d_Drawer)& drawer) {_defaultDrawer = drawer;}
+
+    // shared drawer for the color and edge style, created on first use
+    Handle(Prs3d_Drawer) drawer(const Quantity_Color& color, const occEdgeStyle& edges = occEdgeStyle());
+
+    // use the shared drawer for the object
+    void apply(const Handle(AIS_InteractiveObject)& object, const Quantity_Color& color,
+               const occEdgeStyle& edges = occEdgeStyle());
+
+    int size() const {return _drawers.size();}
+    void clear() {_drawers.clear();}
+
+    // give the object a drawer of its own, linked to the shared one, before it is restyled
+    static void detach(const Handle(AIS_InteractiveObject)& object);
+
+private:
+    Handle(Prs3d_Drawer) _defaultDrawer;
+    QHash<QString, Handle(occSharedDrawer)> _drawers;
+};
+
+#endif // OCCSTYLEREGISTRY_H
@@ -0,0 +1,416 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#include "occtiledimageexporter.h"
+
+// std headers
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QtEndian>
+
+// occ headers
+#include <Graphic3d_Camera.hxx>
+#include <Graphic3d_CameraTile.hxx>
+#include <Image_PixMap.hxx>
+#include <V3d_ImageDumpOptions.hxx>
+
+namespace
+{
+const int bytesPerPixel = 3; // RGB
+
+// Writes an image band by band, top row first.
+class streamWriter
+{
+public:
+    virtual ~streamWriter() = default;
+
+    bool open(const QString& fileName) {_file.setFileName(fileName); return _file.open(QIODevice::WriteOnly | QIODevice::Truncate);}
+    qint64 bytesWritten() const {return _file.pos();}
+    QString errorString() const {return _error.isEmpty() ? _file.errorString() : _error;}
+
+    virtual bool begin(int width, int height, int rowsPerBand) = 0;
+    virtual bool writeBand(const QByteArray& rgb, int nbRows) = 0;
+    virtual bool end() {_file.close(); return _file.error() == QFileDevice::NoError;}
+
+protected:
+    QFile _file;
+    QString _error;
+
+    template <typename T>
+    bool put(T value)
+    {
+        const T little = qToLittleEndian(value);
+        return _file.write(reinterpret_cast<const char*>(&little), sizeof(T)) == sizeof(T);
+    }
+};
+
+
+// Baseline TIFF, uncompressed RGB, one strip per band of tiles.
+class tiffWriter : public streamWriter
+{
+public:
+    bool begin(int width, int height, int rowsPerBand) override
+    {
+        const quint64 stripBytes = quint64(width) * bytesPerPixel * rowsPerBand;
+        const quint32 nbStrips = (height + rowsPerBand - 1) / rowsPerBand;
+        const quint16 nbEntries = 10;
+        const quint32 ifdOffset = 8;
+        const quint32 bitsOffset = ifdOffset + 2 + nbEntries * 12 + 4;
+        const quint32 offsetsOffset = bitsOffset + 6;
+        const quint32 countsOffset = offsetsOffset + 4 * nbStrips;
+        const quint32 dataOffset = countsOffset + 4 * nbStrips;
+
+        // classic TIFF addresses at most 4 GiB
+        if (dataOffset + quint64(width) * bytesPerPixel * height > 0xffffffffULL)
+        {
+            _error = "image exceeds the 4 GiB limit of TIFF files";
+            return false;
+        }
+
+        auto entry = [this](quint16 tag, quint16 type, quint32 count, quint32 value) {
+            bool ok = put<quint16>(tag) && put<quint16>(type) && put<quint32>(count);
+            // SHORT values are stored left-justified in the value field
+            if (type == 3 && count == 1)
+                return ok && put<quint16>(static_cast<quint16>(value)) && put<quint16>(0);
+            return ok && put<quint32>(value);
+        };
+        const quint16 typeShort = 3;
+        const quint16 typeLong = 4;
+
+        bool ok = _file.write("II", 2) == 2 && put<quint16>(42) && put<quint32>(ifdOffset);
+        ok = ok && put<quint16>(nbEntries);
+        ok = ok && entry(256, typeLong, 1, width);
+        ok = ok && entry(257, typeLong, 1, height);
+        ok = ok && entry(258, typeShort, 3, bitsOffset);
+        ok = ok && entry(259, typeShort, 1, 1);                               // no compression
+        ok = ok && entry(262, typeShort, 1, 2);                               // RGB
+        ok = ok && entry(273, typeLong, nbStrips, nbStrips == 1 ? dataOffset : offsetsOffset);
+        ok = ok && entry(277, typeShort, 1, bytesPerPixel);
+        ok = ok && entry(278, typeLong, 1, rowsPerBand);
+        ok = ok && entry(279, typeLong, nbStrips, nbStrips == 1 ? quint32(quint64(width) * bytesPerPixel * height) : countsOffset);
+        ok = ok && entry(284, typeShort, 1, 1);                               // chunky
+        ok = ok && put<quint32>(0);
+
+        ok = ok && put<quint16>(8) && put<quint16>(8) && put<quint16>(8);
+        for (quint32 i = 0; i < nbStrips && ok; i++)
+            ok = put<quint32>(quint32(dataOffset + i * stripBytes));
+        for (quint32 i = 0; i < nbStrips && ok; i++)
+        {
+            const quint32 rows = std::min<quint32>(rowsPerBand, height - i * rowsPerBand);
+            ok = put<quint32>(quint32(quint64(width) * bytesPerPixel * rows));
+        }
+        return ok && _file.pos() == dataOffset;
+    }
+
+    bool writeBand(const QByteArray& rgb, int /*nbRows*/) override
+    {
+        return _file.write(rgb) == rgb.size();
+    }
+};
+
+
+// PNG written as a zlib stream of stored (uncompressed) deflate blocks,
+// which can be produced band by band without buffering the whole image.
+class pngWriter : public streamWriter
+{
+public:
+    bool begin(int width, int height, int /*rowsPerBand*/) override
+    {
+        _width = width;
+        _rowsLeft = height;
+
+        QByteArray header(13, Qt::Uninitialized);
+        qToBigEndian<quint32>(width, header.data());
+        qToBigEndian<quint32>(height, header.data() + 4);
+        header[8] = 8;  // bit depth
+        header[9] = 2;  // RGB
+        header[10] = 0; // deflate
+        header[11] = 0; // adaptive filtering
+        header[12] = 0; // no interlace
+
+        return _file.write("\x89PNG\r\n\x1a\n", 8) == 8 && chunk("IHDR", header);
+    }
+
+    bool writeBand(const QByteArray& rgb, int nbRows) override
+    {
+        const int rowBytes = _width * bytesPerPixel;
+
+        // every scanline starts with filter type 0 (none)
+        QByteArray raw;
+        raw.reserve(nbRows * (rowBytes + 1));
+        for (int row = 0; row < nbRows; row++)
+        {
+            raw.append('\0');
+            raw.append(rgb.constData() + qsizetype(row) * rowBytes, rowBytes);
+        }
+        _adler = adler32(_adler, raw);
+        _rowsLeft -= nbRows;
+
+        QByteArray data;
+        if (_isFirstBand)
+            data.append("\x78\x01", 2); // zlib header, no compression
+        _isFirstBand = false;
+
+        const qsizetype maxBlock = 65535;
+        for (qsizetype pos = 0; pos < raw.size(); pos += maxBlock)
+        {
+            const quint16 length = static_cast<quint16>(std::min(maxBlock, raw.size() - pos));
+            const bool isFinal = _rowsLeft == 0 && pos + length == raw.size();
+            data.append(isFinal ? '\x01' : '\x00');
+            data.append(static_cast<char>(length & 0xff));
+            data.append(static_cast<char>(length >> 8));
+            data.append(static_cast<char>(~length & 0xff));
+            data.append(static_cast<char>((~length >> 8) & 0xff));
+            data.append(raw.constData() + pos, length);
+        }
+
+        if (_rowsLeft == 0)
+        {
+            char adler[4];
+            qToBigEndian<quint32>(_adler, adler);
+            data.append(adler, 4);
+        }
+
+        return chunk("IDAT", data);
+    }
+
+    bool end() override
+    {
+        return chunk("IEND", QByteArray()) && streamWriter::end();
+    }
+
+private:
+    int _width {0};
+    int _rowsLeft {0};
+    bool _isFirstBand {true};
+    quint32 _adler {1};
+
+    bool chunk(const char* type, const QByteArray& data)
+    {
+        char length[4];
+        qToBigEndian<quint32>(data.size(), length);
+
+        quint32 crc = crc32(0xffffffffu, QByteArray::fromRawData(type, 4));
+        crc = crc32(crc, data) ^ 0xffffffffu;
+        char crcBytes[4];
+        qToBigEndian<quint32>(crc, crcBytes);
+
+        return _file.write(length, 4) == 4
+                && _file.write(type, 4) == 4
+                && _file.write(data) == data.size()
+                && _file.write(crcBytes, 4) == 4;
+    }
+
+    static quint32 crc32(quint32 crc, const QByteArray& data)
+    {
+        static const auto table = [] {
+            std::array<quint32, 256> t {};
+            for (quint32 n = 0; n < 256; n++)
+            {
+                quint32 c = n;
+                for (int k = 0; k < 8; k++)
+                    c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+                t[n] = c;
+            }
+            return t;
+        }();
+
+        for (const char byte : data)
+            crc = table[(crc ^ static_cast<quint8>(byte)) & 0xff] ^ (crc >> 8);
+        return crc;
+    }
+
+    static quint32 adler32(quint32 adler, const QByteArray& data)
+    {
+        quint32 a = adler & 0xffff;
+        quint32 b = adler >> 16;
+        const qsizetype nmax = 5552; // largest block without overflow before the modulo
+        for (qsizetype pos = 0; pos < data.size(); pos += nmax)
+        {
+            const qsizetype end = std::min(data.size(), pos + nmax);
+            for (qsizetype i = pos; i < end; i++)
+            {
+                a += static_cast<quint8>(data.at(i));
+                b += a;
+            }
+            a %= 65521;
+            b %= 65521;
+        }
+        return (b << 16) | a;
+    }
+};
+}
+
+
+double occTiledExportReport::megapixelsPerSecond(const occTiledExportSettings& settings) const
+{
+    if (msecs <= 0)
+        return 0.0;
+
+    return double(settings.width) * settings.height / 1.0e6 / (msecs / 1000.0);
+}
+
+
+QString occTiledExportReport::toString(const occTiledExportSettings& settings) const
+{
+    if (!isDone)
+        return error;
+
+    return QString("%1x%2 pixels in %3 tiles, %4 s, %5 MPixel/s, %6 MiB/s")
+            .arg(settings.width)
+            .arg(settings.height)
+            .arg(nbTiles)
+            .arg(msecs / 1000.0, 0, 'f', 1)
+            .arg(megapixelsPerSecond(settings), 0, 'f', 1)
+            .arg(msecs > 0 ? bytesWritten / (1024.0 * 1024.0) / (msecs / 1000.0) : 0.0, 0, 'f', 1);
+}
+
+
+occTiledImageExporter::occTiledImageExporter(const Handle(V3d_View)& view)
+    : _view(view)
+{
+}
+
+
+bool occTiledImageExporter::exportImage(const occTiledExportSettings& settings,
+                                        const std::function<bool(int)>& progress)
+{
+    _report = occTiledExportReport();
+
+    if (settings.width <= 0 || settings.height <= 0 || settings.tileSize <= 0)
+    {
+        _report.error = "invalid image or tile size";
+        return false;
+    }
+
+    std::unique_ptr<streamWriter> writer;
+    const QString suffix = QFileInfo(settings.fileName).suffix().toLower();
+    if (suffix == "png")
+        writer = std::make_unique<pngWriter>();
+    else if (suffix == "tif" || suffix == "tiff")
+        writer = std::make_unique<tiffWriter>();
+    else
+    {
+        _report.error = "only PNG and TIFF files can be streamed";
+        return false;
+    }
+
+    const int rowsPerBand = std::min(settings.tileSize, settings.height);
+    if (!writer->open(settings.fileName) || !writer->begin(settings.width, settings.height, rowsPerBand))
+    {
+        _report.error = QString("cannot write %1: %2").arg(settings.fileName, writer->errorString());
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // the tiles are cut from a camera with the aspect ratio of the full image
+    const Handle(Graphic3d_Camera)& camera = _view->Camera();
+    Handle(Graphic3d_Camera) savedCamera = new Graphic3d_Camera();
+    savedCamera->Copy(camera);
+    camera->SetAspect(Standard_Real(settings.width) / Standard_Real(settings.height));
+
+    V3d_ImageDumpOptions options;
+    options.BufferType = Graphic3d_BT_RGB;
+    options.ToAdjustAspect = Standard_False;
+
+    const int nbBands = (settings.height + rowsPerBand - 1) / rowsPerBand;
+    const qsizetype bandRowBytes = qsizetype(settings.width) * bytesPerPixel;
+    QByteArray band;
+
+    bool isDone = true;
+    for (int bandIndex = 0; bandIndex < nbBands && isDone; bandIndex++)
+    {
+        const int y = bandIndex * rowsPerBand;
+        const int bandHeight = std::min(rowsPerBand, settings.height - y);
+        band.resize(bandRowBytes * bandHeight);
+
+        for (int x = 0; x < settings.width && isDone; x += settings.tileSize)
+        {
+            const int tileWidth = std::min(settings.tileSize, settings.width - x);
+
+            Graphic3d_CameraTile tile;
+            tile.TotalSize.SetValues(settings.width, settings.height);
+            tile.TileSize.SetValues(tileWidth, bandHeight);
+            tile.Offset.SetValues(x, y);
+            tile.IsTopDown = true;
+            camera->SetTile(tile);
+
+            options.Width = tileWidth;
+            options.Height = bandHeight;
+
+            Image_PixMap pixmap;
+            if (!_view->ToPixMap(pixmap, options) || pixmap.SizeX() != Standard_Size(tileWidth))
+            {
+                _report.error = "cannot render tile";
+                isDone = false;
+                break;
+            }
+
+            // Row() returns the rows top down regardless of the pixmap layout
+            for (int row = 0; row < bandHeight; row++)
+                std::memcpy(band.data() + row * bandRowBytes + qsizetype(x) * bytesPerPixel,
+                            pixmap.Row(row), size_t(tileWidth) * bytesPerPixel);
+
+            _report.nbTiles++;
+        }
+
+        if (isDone && !writer->writeBand(band, bandHeight))
+        {
+            _report.error = QString("cannot write %1: %2").arg(settings.fileName, writer->errorString());
+            isDone = false;
+        }
+
+        if (isDone && progress && !progress(100 * (bandIndex + 1) / nbBands))
+        {
+            _report.error = "cancelled";
+            isDone = false;
+        }
+    }
+
+    camera->Copy(savedCamera);
+    _view->Redraw();
+
+    _report.bytesWritten = writer->bytesWritten();
+    isDone = writer->end() && isDone;
+    _report.msecs = timer.elapsed();
+    _report.isDone = isDone;
+
+    if (!isDone)
+        QFile::remove(settings.fileName);
+
+    return isDone;
+}
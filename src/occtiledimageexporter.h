@@ -0,0 +1,88 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#ifndef OCCTILEDIMAGEEXPORTER_H
+#define OCCTILEDIMAGEEXPORTER_H
+
+// std headers
+#include <functional>
+
+// Qt headers
+#include <QString>
+
+// occ headers
+#include <V3d_View.hxx>
+
+struct occTiledExportSettings
+{
+    int width {8192};
+    int height {8192};
+    int tileSize {2048};   // edge length of the rendered tiles in pixels
+    QString fileName;      // .png or .tif/.tiff
+};
+
+struct occTiledExportReport
+{
+    int nbTiles {0};
+    qint64 msecs {0};
+    qint64 bytesWritten {0};
+    bool isDone {false};
+    QString error;
+
+    double megapixelsPerSecond(const occTiledExportSettings& settings) const;
+    QString toString(const occTiledExportSettings& settings) const;
+};
+
+/*
+  occTiledImageExporter renders images far larger than the window or the
+  maximum frame buffer size. The camera frustum is split into tiles with
+  Graphic3d_CameraTile and each tile is rendered with V3d_View::ToPixMap.
+  A row of tiles is written to disk as soon as it is complete, so memory
+  use is bounded by one row of tiles regardless of the image size.
+*/
+
+class occTiledImageExporter
+{
+public:
+
+    // constructor
+    explicit occTiledImageExporter(const Handle(V3d_View)& view);
+
+    // Render and write the image. The progress function receives the progress
+    // in percent and may return false to cancel the export.
+    bool exportImage(const occTiledExportSettings& settings,
+                     const std::function<bool(int)>& progress = {});
+
+    const occTiledExportReport& report() const {return _report;}
+
+private:
+    Handle(V3d_View) _view;
+    occTiledExportReport _report;
+};
+
+#endif // OCCTILEDIMAGEEXPORTER_H
@@ -0,0 +1,315 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#include "occturntablerecorder.h"
+
+// std headers
+#include <cmath>
+#include <cstring>
+
+// Qt headers
+#include <QDir>
+#include <QFileInfo>
+#include <QImageWriter>
+#include <QtConcurrent/QtConcurrentRun>
+
+// occ headers
+#include <V3d_ImageDumpOptions.hxx>
+#include <gp_Ax1.hxx>
+#include <gp_Trsf.hxx>
+
+// project headers
+#include "occimage.h"
+#include "occview.h"
+
+namespace
+{
+// bytes the encoder process may lag behind before the recorder waits for it
+const qint64 maxEncoderBacklog {256ll * 1024 * 1024};
+}
+
+
+occTurntableRecorder::occTurntableRecorder(occView* view, QObject *parent)
+    : QObject(parent),
+      _view(view)
+{
+    // one worker per frame buffer
+    _pool.setMaxThreadCount(2);
+
+    _frameTimer.setSingleShot(true);
+    _frameTimer.setInterval(0);
+    connect(&_frameTimer, &QTimer::timeout, this, &occTurntableRecorder::renderFrame);
+}
+
+
+occTurntableRecorder::~occTurntableRecorder()
+{
+    _frameTimer.stop();
+    _pool.waitForDone();
+    if (_encoder.state() != QProcess::NotRunning)
+    {
+        _encoder.kill();
+        _encoder.waitForFinished();
+    }
+}
+
+
+bool occTurntableRecorder::start(const occRecorderSettings& settings)
+{
+    if (isRunning() || _encoder.state() != QProcess::NotRunning)
+        return false;
+
+    _settings = settings;
+    _settings.nbFrames = std::max(1, _settings.nbFrames);
+    _settings.framesPerSecond = std::max(1, _settings.framesPerSecond);
+    _error.clear();
+
+    // video encoders expect even frame dimensions
+    const Handle(V3d_View)& view = _view->getView();
+    view->Window()->Size(_width, _height);
+    _width &= ~1;
+    _height &= ~1;
+    if (_width <= 0 || _height <= 0)
+    {
+        emit finished("the view is too small to record");
+        return false;
+    }
+
+    if (!_settings.encoder.isEmpty())
+    {
+        _encoder.setProgram(_settings.encoder);
+        _encoder.setArguments({"-y", "-loglevel", "error",
+                               "-f", "rawvideo", "-pix_fmt", "rgb24",
+                               "-s", QString("%1x%2").arg(_width).arg(_height),
+                               "-r", QString::number(_settings.framesPerSecond),
+                               "-i", "-",
+                               "-pix_fmt", "yuv420p",
+                               _settings.fileName});
+        _encoder.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+        _encoder.start(QIODevice::WriteOnly);
+        if (!_encoder.waitForStarted())
+        {
+            _error = QString("cannot start %1: %2").arg(_settings.encoder, _encoder.errorString());
+            emit finished(_error);
+            return false;
+        }
+    }
+
+    _savedCamera = new Graphic3d_Camera();
+    _savedCamera->Copy(view->Camera());
+
+    occView::applyViewPreset(view, occViewEnums::viewAxo);
+    _startCamera = new Graphic3d_Camera();
+    _startCamera->Copy(view->Camera());
+
+    _frame = 0;
+    _clock.start();
+    _frameTimer.start();
+    return true;
+}
+
+
+void occTurntableRecorder::cancel()
+{
+    if (isRunning())
+        finish(true);
+}
+
+
+void occTurntableRecorder::renderFrame()
+{
+    if (!isRunning())
+        return;
+
+    if (_frame >= _settings.nbFrames)
+    {
+        finish(false);
+        return;
+    }
+
+    // both buffers in use: the older frame has to be encoded before its buffer is reused
+    while (_pending.size() >= 2)
+    {
+        if (!completeOldest())
+        {
+            finish(true);
+            return;
+        }
+    }
+
+    // turn the axo camera around the vertical axis through its center
+    const Handle(V3d_View)& view = _view->getView();
+    gp_Trsf rotation;
+    rotation.SetRotation(gp_Ax1(_startCamera->Center(), gp::DZ()), 2.0 * M_PI * _frame / _settings.nbFrames);
+    view->Camera()->SetEyeAndCenter(_startCamera->Eye().Transformed(rotation), _startCamera->Center());
+    view->Camera()->SetUp(_startCamera->Up().Transformed(rotation));
+
+    Handle(Image_PixMap)& buffer = _buffers[_frame % 2];
+    if (buffer.IsNull())
+        buffer = new Image_PixMap();
+
+    V3d_ImageDumpOptions options;
+    options.Width = _width;
+    options.Height = _height;
+    options.BufferType = Graphic3d_BT_RGB;
+    if (!view->ToPixMap(*buffer, options))
+    {
+        _error = "cannot read back the frame buffer";
+        finish(true);
+        return;
+    }
+
+    const Handle(Image_PixMap) pixmap = buffer;
+    const bool isPiped = !_settings.encoder.isEmpty();
+    const QString fileName = isPiped ? QString() : frameFileName(_frame);
+
+    _pending.enqueue({_frame, QtConcurrent::run(&_pool, [pixmap, isPiped, fileName] {
+        encodedFrame frame;
+        if (isPiped)
+        {
+            // tightly packed RGB rows, top row first
+            const size_t rowBytes = pixmap->SizeX() * 3;
+            frame.raw = QByteArray(static_cast<qsizetype>(rowBytes * pixmap->SizeY()), Qt::Uninitialized);
+            for (Standard_Size row = 0; row < pixmap->SizeY(); row++)
+                std::memcpy(frame.raw.data() + row * rowBytes, pixmap->Row(row), rowBytes);
+            return frame;
+        }
+
+        QImageWriter writer(fileName);
+        if (!writer.write(pixmapToImage(*pixmap)))
+            frame.error = writer.errorString();
+        return frame;
+    })});
+
+    ++_frame;
+    emit progress(100 * _frame / _settings.nbFrames);
+    _frameTimer.start();
+}
+
+
+bool occTurntableRecorder::completeOldest()
+{
+    pendingFrame frame = _pending.dequeue();
+    const encodedFrame result = frame.future.result();
+
+    if (!result.error.isEmpty())
+    {
+        _error = QString("frame %1: %2").arg(frame.index + 1).arg(result.error);
+        return false;
+    }
+
+    if (_settings.encoder.isEmpty())
+        return true;
+
+    if (_encoder.state() != QProcess::Running)
+    {
+        _error = QString("%1 stopped").arg(_settings.encoder);
+        return false;
+    }
+
+    _encoder.write(result.raw);
+    while (_encoder.bytesToWrite() > maxEncoderBacklog)
+    {
+        if (!_encoder.waitForBytesWritten(-1))
+        {
+            _error = QString("%1: %2").arg(_settings.encoder, _encoder.errorString());
+            return false;
+        }
+    }
+    return true;
+}
+
+
+void occTurntableRecorder::finish(bool isCancelled)
+{
+    _frameTimer.stop();
+
+    while (!_pending.isEmpty())
+    {
+        if (isCancelled)
+            _pending.dequeue().future.waitForFinished();
+        else if (!completeOldest())
+            isCancelled = true;
+    }
+
+    const int nbFrames = _frame;
+    const qint64 msecs = _clock.elapsed();
+    _frame = -1;
+
+    const Handle(V3d_View)& view = _view->getView();
+    view->Camera()->Copy(_savedCamera);
+    view->Redraw();
+
+    const double fps = msecs > 0 ? 1000.0 * nbFrames / msecs : 0.0;
+    QString summary = QString("%1 frames of %2x%3 in %4 s, %5 fps")
+            .arg(nbFrames)
+            .arg(_width)
+            .arg(_height)
+            .arg(msecs / 1000.0, 0, 'f', 1)
+            .arg(fps, 0, 'f', 1);
+    if (!_error.isEmpty())
+        summary = _error;
+    else if (isCancelled)
+        summary.append(", cancelled");
+
+    if (_encoder.state() == QProcess::NotRunning)
+    {
+        emit finished(summary);
+        return;
+    }
+
+    if (isCancelled)
+    {
+        _encoder.kill();
+        _encoder.waitForFinished();
+        emit finished(summary);
+        return;
+    }
+
+    // the encoder finishes the video after the end of the input
+    _encoder.closeWriteChannel();
+    connect(&_encoder, qOverload<int, QProcess::ExitStatus>(&QProcess::finished), this,
+            [this, summary](int exitCode, QProcess::ExitStatus status) {
+        disconnect(&_encoder, nullptr, this, nullptr);
+        if (status == QProcess::NormalExit && exitCode == 0)
+            emit finished(summary);
+        else
+            emit finished(QString("%1 failed with exit code %2").arg(_settings.encoder).arg(exitCode));
+    });
+}
+
+
+QString occTurntableRecorder::frameFileName(int index) const
+{
+    const QFileInfo info(_settings.fileName);
+    const QString suffix = info.suffix().isEmpty() ? QString("png") : info.suffix();
+    return info.dir().filePath(QString("%1_%2.%3")
+                               .arg(info.completeBaseName())
+                               .arg(index + 1, 4, 10, QChar('0'))
+                               .arg(suffix));
+}
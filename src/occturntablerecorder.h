@@ -0,0 +1,126 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+#ifndef OCCTURNTABLERECORDER_H
+#define OCCTURNTABLERECORDER_H
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QObject>
+#include <QProcess>
+#include <QQueue>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+
+// occ headers
+#include <Graphic3d_Camera.hxx>
+#include <Image_PixMap.hxx>
+
+class occView;
+
+struct occRecorderSettings
+{
+    int nbFrames {120};     // frames of one full turn
+    int framesPerSecond {30};
+    QString fileName;       // video file if an encoder is set, else the base name of the image sequence
+    QString encoder;        // ffmpeg executable, raw frames are piped to it if set
+};
+
+/*
+  occTurntableRecorder orbits the camera once around the scene, starting at
+  the axo preset, and captures a fixed number of frames. Two frame buffers
+  alternate: while the worker converts and encodes frame N, the GUI thread
+  already renders and reads back frame N+1. The frames are written as a
+  numbered image sequence (name_0001.png, ...) or piped as raw RGB to an
+  encoder process such as ffmpeg.
+*/
+
+class occTurntableRecorder : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    // constructor
+    explicit occTurntableRecorder(occView* view, QObject *parent = nullptr);
+
+    // destructor, waits for the encoding workers
+    ~occTurntableRecorder();
+
+    bool start(const occRecorderSettings& settings);
+    bool isRunning() const {return _frame >= 0;}
+
+    // running or waiting for the encoder process to finish the video
+    bool isBusy() const {return isRunning() || _encoder.state() != QProcess::NotRunning;}
+
+public slots:
+    void cancel();
+
+signals:
+    void progress(int percent);
+    void finished(const QString& summary);
+
+private:
+    struct encodedFrame
+    {
+        QByteArray raw;     // frame for the encoder process, empty for image files
+        QString error;
+    };
+
+    struct pendingFrame
+    {
+        int index;
+        QFuture<encodedFrame> future;
+    };
+
+    occView* _view;
+    occRecorderSettings _settings;
+    QTimer _frameTimer;
+    QThreadPool _pool;
+    QProcess _encoder;
+
+    // recording state
+    int _frame {-1};
+    int _width {0};
+    int _height {0};
+    Handle(Graphic3d_Camera) _savedCamera;
+    Handle(Graphic3d_Camera) _startCamera;
+    Handle(Image_PixMap) _buffers[2];
+    QQueue<pendingFrame> _pending;
+    QElapsedTimer _clock;
+    QString _error;
+
+    void renderFrame();
+    bool completeOldest();
+    void finish(bool isCancelled);
+    QString frameFileName(int index) const;
+};
+
+#endif // OCCTURNTABLERECORDER_H
@@ -20,12 +20,17 @@
 #include <QColorDialog>
 #include <QCursor>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QFileInfo>
 #include <QFileDialog>
-#include <QDebug>
+#include <QInputDialog>
+#include <QMap>
+#include <QMessageBox>
 #include <QMouseEvent>
 #include <QOperatingSystemVersion>
 #include <QPalette>
+#include <QProgressDialog>
+#include <QScreen>
 #include <QStyleFactory>
 #include <QSurfaceFormat>
 #include <QWheelEvent>
@@ -36,8 +41,18 @@
 #include <Graphic3d_GraphicDriver.hxx>
 #include <Graphic3d_TextureEnv.hxx>
 #include <OpenGl_GraphicDriver.hxx>
+#include <Prs3d_LineAspect.hxx>
+#include <Standard_Version.hxx>
 
 // private headers
+#include "occareaselector.h"
+#include "occimageexporter.h"
+#include "occselectionmodes.h"
+#include "occshadercache.h"
+#include "occstartupprofiler.h"
+#include "occstatsoverlay.h"
+#include "occstyleregistry.h"
+#include "occtiledimageexporter.h"
 #include "occwindow.h"
 #include "occviewcontextmenu.h"
 
@@ -90,9 +105,12 @@ static QCursor* zoomCursor    = nullptr;
 static QCursor* rotCursor     = nullptr;
 
 
-occView::occView(QWidget *parent) : QWidget(parent), _devPx(devicePixelRatio())
+occView::occView(QWidget *parent) : QWidget(parent), _devPx(devicePixelRatio()),
+    _imageExporter(new occImageExporter(this))
 {
-    init();
+    // by default the viewer is created after the window was painted for the first time
+    if (qEnvironmentVariableIsSet("OCCQT6_EAGER_INIT"))
+        init();
 
     _mouseDefaultGestures = myMouseGestureMap;
     _curMode = occViewEnums::curAction3d::Nothing;
@@ -106,6 +124,28 @@ occView::occView(QWidget *parent) : QWidget(parent), _devPx(devicePixelRatio())
     // Enable mouse tracking, by default mouse tracking is disabled.
     setMouseTracking(true);
 
+    // pace viewer updates to the refresh rate of the screen
+    const qreal refreshRate = screen() ? screen()->refreshRate() : 60.0;
+    _frameTimer.setSingleShot(true);
+    _frameTimer.setTimerType(Qt::PreciseTimer);
+    _frameTimer.setInterval(qRound(1000.0 / (refreshRate > 0.0 ? refreshRate : 60.0)));
+    connect(&_frameTimer, &QTimer::timeout, this, &occView::onFrameTick);
+
+    _restoreQualityTimer.setSingleShot(true);
+    connect(&_restoreQualityTimer, &QTimer::timeout, this, &occView::endInteraction);
+
+    // the next path tracing sample is requested once the previous frame was drawn
+    _accumulationTimer.setSingleShot(true);
+    _accumulationTimer.setInterval(0);
+    connect(&_accumulationTimer, &QTimer::timeout, this, [this] {
+        _view->Invalidate();
+        update();
+    });
+
+    _hoverTimer.setSingleShot(true);
+    _hoverTimer.setTimerType(Qt::PreciseTimer);
+    connect(&_hoverTimer, &QTimer::timeout, this, &occView::onHoverTimer);
+
     this->update();
 }
 
@@ -120,12 +160,19 @@ occView::~occView()
 // ------------------------------------------------------------------------------------------------
 void occView::init()
 {
+    if (isInitialized())
+        return;
+
     Handle(Aspect_DisplayConnection) aDisplayConnection;
     Handle_OpenGl_GraphicDriver aGraphicDriver;
 
+    // keep compiled shaders across runs, must precede the first OpenGL context
+    occShaderCache::configure();
+
     // Create a 3D viewer.
     aDisplayConnection = new Aspect_DisplayConnection();
     aGraphicDriver = new OpenGl_GraphicDriver(aDisplayConnection);
+    occStartupProfiler::mark("graphic driver created");
 
     // fix OpenGL issues on MacOS: https://old.opencascade.com/content/ray-tracing-requires-opengl-31-and-higher
 #if __APPLE__
@@ -135,6 +182,7 @@ void occView::init()
 #endif
 
     _viewer = new V3d_Viewer(aGraphicDriver);
+    occStartupProfiler::mark("viewer created");
 
     // Create a graphic structure in this Viewer
     _struct = new Graphic3d_Structure (_viewer->StructureManager());
@@ -142,6 +190,7 @@ void occView::init()
     // Create an interactive context.
     _context = new AIS_InteractiveContext(_viewer);
     _context->SetDisplayMode(AIS_Shaded, Standard_True);
+    _selectionModes = new occSelectionModes(_context, this);
 
     _curDrawStyle = occViewEnums::drawStyle::shadedWithEdges;
 
@@ -155,6 +204,13 @@ void occView::init()
         hWnd->Map();
 
     _view->MustBeResized();
+    occStartupProfiler::mark("view window attached");
+
+    _areaSelector = new occAreaSelector(_context, _view, _selectionModes, this);
+    connect(_areaSelector, &occAreaSelector::selectionChanged, this, [this] {
+        _context->UpdateCurrentViewer();
+    });
+    connect(_areaSelector, &occAreaSelector::finished, this, &occView::selectionChanged);
 
     // Set up lights etc
     _viewer->SetDefaultLights();
@@ -176,6 +232,10 @@ void occView::init()
 
     if (_isRaytracing)
         _view->ChangeRenderingParams().Method = Graphic3d_RM_RAYTRACING;
+
+    occStartupProfiler::mark("viewer initialized");
+    emit viewerInitialized();
+    update();
 }
 
 
@@ -189,9 +249,54 @@ QPaintEngine* occView::paintEngine() const
 
 void occView::paintEvent( QPaintEvent* /*event*/ )
 {
+    if (!isInitialized())
+    {
+        // the window is visible now, create the viewer on the next turn of the event loop
+        if (!_isInitScheduled)
+        {
+            _isInitScheduled = true;
+            occStartupProfiler::mark("first paint");
+            QTimer::singleShot(0, this, &occView::init);
+        }
+        return;
+    }
+
+    // a tiled export owns the camera
+    if (_isExporting)
+        return;
+
+    if (!_isFirstFrameDone)
+    {
+        // the first frame compiles the rasterization shaders
+        _isFirstFrameDone = true;
+        occShaderCache::measure("first frame", [this] {
+            _view->InvalidateImmediate();
+            FlushViewEvents(_context, _view, true);
+        });
+        occStartupProfiler::mark("first frame");
+        occStartupProfiler::finish();
+        return;
+    }
+
+    QElapsedTimer renderTimer;
+    renderTimer.start();
+
     _view->InvalidateImmediate();
     FlushViewEvents(_context, _view, true);
     //    _view->Redraw();
+
+    // repaints of the overlay itself would fill the histogram of an idle view
+    const double renderMsecs = renderTimer.nsecsElapsed() / 1.0e6;
+    if (_statsOverlay && _statsOverlay->isVisible() && !_isOverlayRefresh)
+        _statsOverlay->addFrame(renderMsecs);
+    _isOverlayRefresh = false;
+
+    // smoothed render time at full quality, decides on reduced quality during gestures
+    if (!_isInteracting)
+        _renderMsecs = _renderMsecs > 0.0 ? 0.8 * _renderMsecs + 0.2 * renderMsecs : renderMsecs;
+
+    if (_isProgressive)
+        onFrameAccumulated();
 }
 
 void occView::resizeEvent( QResizeEvent* /*event*/ )
@@ -206,8 +311,234 @@ void occView::OnSelectionChanged(const Handle(AIS_InteractiveContext)&,
     emit selectionChanged();
 }
 
+void occView::handleDynamicHighlight(const Handle(AIS_InteractiveContext)& theCtx,
+                                     const Handle(V3d_View)& theView)
+{
+    if (!myGL.MoveTo.ToHilight)
+    {
+        AIS_ViewController::handleDynamicHighlight(theCtx, theView);
+        return;
+    }
+
+    const bool isGesture = _isInteracting || QApplication::mouseButtons() != Qt::NoButton;
+    if (!_hoverSettings.isEnabled || (_hoverSettings.skipDuringGestures && isGesture))
+    {
+        // the pick is dropped, the next move after the gesture picks again
+        _hoverTimer.stop();
+        myGL.MoveTo.ToHilight = false;
+        ++_skippedHoverPicks;
+        AIS_ViewController::handleDynamicHighlight(theCtx, theView);
+        return;
+    }
+
+    const qint64 interval = _hoverSettings.maxRate > 0.0 ? qint64(1000.0 / _hoverSettings.maxRate) : 0;
+    if (_hoverClock.isValid() && _hoverClock.elapsed() < interval)
+    {
+        // remember the position and pick once the interval is over, later moves replace it
+        _hoverPoint = myGL.MoveTo.Point;
+        myGL.MoveTo.ToHilight = false;
+        ++_skippedHoverPicks;
+        if (!_hoverTimer.isActive())
+            _hoverTimer.start(int(interval - _hoverClock.elapsed()));
+        AIS_ViewController::handleDynamicHighlight(theCtx, theView);
+        return;
+    }
+
+    _hoverTimer.stop();
+    _hoverClock.start();
+
+    QElapsedTimer pickTimer;
+    pickTimer.start();
+    AIS_ViewController::handleDynamicHighlight(theCtx, theView);
+    const double pickMsecs = pickTimer.nsecsElapsed() / 1.0e6;
+
+    ++_hoverPicks;
+    _hoverPickMsecs += pickMsecs;
+    if (_statsOverlay && _statsOverlay->isVisible())
+        _statsOverlay->addHoverPick(pickMsecs);
+}
+
+void occView::onHoverTimer()
+{
+    if (!isInitialized())
+        return;
+
+    // replay the latest deferred position as a fresh mouse move
+    myUI.MoveTo.ToHilight = true;
+    myUI.MoveTo.Point = _hoverPoint;
+    updateView();
+}
+
+void occView::handleSelectionPoly(const Handle(AIS_InteractiveContext)& theCtx,
+                                  const Handle(V3d_View)& theView)
+{
+    const bool isArea = myGL.Selection.Tool == AIS_ViewSelectionTool_RubberBand
+            || myGL.Selection.Tool == AIS_ViewSelectionTool_Polygon;
+    if (!myGL.Selection.ToApplyTool || !isArea || _areaSelector == nullptr)
+    {
+        AIS_ViewController::handleSelectionPoly(theCtx, theView);
+        return;
+    }
+
+    QVector<Graphic3d_Vec2i> points;
+    for (NCollection_Sequence<Graphic3d_Vec2i>::Iterator it(myGL.Selection.Points); it.More(); it.Next())
+        points.append(it.Value());
+
+#if OCC_VERSION_HEX >= 0x070600
+    const bool isXor = myGL.Selection.Scheme == AIS_SelectionScheme_XOR;
+#else
+    const bool isXor = myGL.Selection.IsXOR;
+#endif
+
+    // without points the view controller only removes the rubber band
+    myGL.Selection.Points.Clear();
+    myGL.Selection.ToApplyTool = false;
+    AIS_ViewController::handleSelectionPoly(theCtx, theView);
+
+    _areaSelector->select(points, myGL.Selection.Tool == AIS_ViewSelectionTool_RubberBand, isXor);
+}
+
+void occView::handleViewRedraw(const Handle(AIS_InteractiveContext)& theCtx,
+                               const Handle(V3d_View)& theView)
+{
+    AIS_ViewController::handleViewRedraw(theCtx, theView);
+
+    // keep animations (e.g. smooth zoom) running at frame rate, these frames
+    // are not input events and bypass the input folding of updateView()
+    if (myToAskNextFrame)
+    {
+        _isOverlayRefresh = false;
+        this->update();
+    }
+}
+
+void occView::beginScene()
+{
+    ++_sceneDepth;
+}
+
+void occView::commitScene(bool fit)
+{
+    if (_sceneDepth == 0)
+        return;
+
+    // a fit requested by a nested transaction is kept for the outermost commit
+    if (fit && _isSceneDirty)
+        _isFitPending = true;
+
+    if (--_sceneDepth > 0)
+        return;
+
+    if (_isFitPending)
+    {
+        _view->FitAll(0.01, Standard_False);
+        _view->ZFitAll();
+    }
+
+    if (_isSceneDirty || _isFitPending)
+        _context->UpdateCurrentViewer();
+
+    _isSceneDirty = false;
+    _isFitPending = false;
+}
+
+void occView::display(const Handle(AIS_InteractiveObject)& object)
+{
+    // no selection mode yet, computing it for every object would stall large scenes
+    const int displayMode = object->HasDisplayMode() ? object->DisplayMode() : _context->DisplayMode();
+    _context->Display(object, displayMode, -1, !isInScene());
+    _selectionModes->add(object);
+    _isSceneDirty |= isInScene();
+}
+
+void occView::erase(const Handle(AIS_InteractiveObject)& object)
+{
+    _selectionModes->remove(object);
+    _context->Erase(object, !isInScene());
+    _isSceneDirty |= isInScene();
+}
+
+void occView::remove(const Handle(AIS_InteractiveObject)& object)
+{
+    _selectionModes->remove(object);
+    _context->Remove(object, !isInScene());
+    _isSceneDirty |= isInScene();
+}
+
+void occView::setColor(const Handle(AIS_InteractiveObject)& object, const Quantity_Color& color)
+{
+    // the drawer may be shared with other objects, don't recolor them all
+    occStyleRegistry::detach(object);
+    _context->SetColor(object, color, !isInScene());
+    _isSceneDirty |= isInScene();
+}
+
+void occView::setDisplayMode(const Handle(AIS_InteractiveObject)& object, int mode)
+{
+    // the display mode is stored in the drawer as well
+    occStyleRegistry::detach(object);
+    _context->SetDisplayMode(object, mode, !isInScene());
+    _isSceneDirty |= isInScene();
+}
+
+void occView::setTransparency(const Handle(AIS_InteractiveObject)& object, double transparency)
+{
+    occStyleRegistry::detach(object);
+    _context->SetTransparency(object, transparency, !isInScene());
+    _isSceneDirty |= isInScene();
+}
+
+void occView::setMaterial(const Handle(AIS_InteractiveObject)& object, const Graphic3d_MaterialAspect& material)
+{
+    occStyleRegistry::detach(object);
+    _context->SetMaterial(object, material, !isInScene());
+    _isSceneDirty |= isInScene();
+}
+
+void occView::setWidth(const Handle(AIS_InteractiveObject)& object, double width)
+{
+    occStyleRegistry::detach(object);
+    _context->SetWidth(object, width, !isInScene());
+    _isSceneDirty |= isInScene();
+}
+
+TopAbs_ShapeEnum occView::selectionMode() const
+{
+    return _selectionModes ? _selectionModes->shapeType() : TopAbs_SHAPE;
+}
+
+void occView::setSelectionMode(TopAbs_ShapeEnum shapeType)
+{
+    if (!isInitialized())
+        return;
+
+    _context->ClearSelected(Standard_False);
+    _context->ClearDetected(Standard_False);
+    _selectionModes->setShapeType(shapeType);
+    _context->UpdateCurrentViewer();
+}
+
+void occView::fitAll()
+{
+    if (!isInitialized())
+        return;
+
+    if (isInScene())
+    {
+        _isFitPending = true;
+        return;
+    }
+
+    _view->FitAll();
+    _view->ZFitAll();
+    _view->Redraw();
+}
+
 void occView::wireframe()
 {
+    if (!isInitialized())
+        return;
+
     QApplication::setOverrideCursor(Qt::WaitCursor);
     _view->SetComputedMode(false);
     _context->SetDisplayMode(AIS_Shaded, Standard_False);
@@ -219,6 +550,9 @@ void occView::wireframe()
 
 void occView::hlrOn()
 {
+    if (!isInitialized())
+        return;
+
     QApplication::setOverrideCursor(Qt::WaitCursor);
     _view->SetComputedMode(true);
     _view->Redraw();
@@ -228,6 +562,9 @@ void occView::hlrOn()
 
 void occView::hlrOff()
 {
+    if (!isInitialized())
+        return;
+
     QApplication::setOverrideCursor(Qt::WaitCursor);
     _view->SetComputedMode(false);
     _view->Redraw();
@@ -236,6 +573,9 @@ void occView::hlrOff()
 
 void occView::shaded()
 {
+    if (!isInitialized())
+        return;
+
     QApplication::setOverrideCursor(Qt::WaitCursor);
     _context->SetDisplayMode(AIS_Shaded, Standard_True);
     _view->SetComputedMode(false);
@@ -247,6 +587,9 @@ void occView::shaded()
 
 void occView::setRaytracedShadows(bool state)
 {
+    if (!isInitialized())
+        return;
+
     _view->ChangeRenderingParams().IsShadowEnabled = state;
     _isShadowsEnabled = state;
     _context->UpdateCurrentViewer();
@@ -254,6 +597,9 @@ void occView::setRaytracedShadows(bool state)
 
 void occView::setRaytracedReflections(bool state)
 {
+    if (!isInitialized())
+        return;
+
     _view->ChangeRenderingParams().IsReflectionEnabled = state;
     _isReflectionsEnabled = state;
     _context->UpdateCurrentViewer();
@@ -286,8 +632,201 @@ void occView::onRaytraceAction()
 }
 
 
+void occView::saveImage()
+{
+    if (!isInitialized())
+        return;
+
+    QStringList filters;
+    for (const auto& format : occImageExporter::supportedFormats())
+        filters.append(QString("%1 image (*.%2)").arg(format.toUpper(), format));
+
+    const QString fileName = QFileDialog::getSaveFileName(this, "Save image", _imageFileName, filters.join(";;"));
+    if (fileName.isEmpty())
+        return;
+
+    _imageFileName = fileName;
+    saveImage(fileName);
+}
+
+
+bool occView::saveImage(const QString& fileName, int quality)
+{
+    if (!isInitialized())
+        return false;
+
+    return _imageExporter->save(_view, fileName, quality);
+}
+
+
+void occView::setProgressiveRendering(bool isEnabled)
+{
+    if (!isInitialized())
+        return;
+
+    if (isEnabled == _isProgressive)
+        return;
+
+    endInteraction();
+    Graphic3d_RenderingParams& params = _view->ChangeRenderingParams();
+
+    if (isEnabled)
+    {
+        _savedGlobalIllumination = params.IsGlobalIlluminationEnabled;
+        _savedRaytracingDepth = params.RaytracingDepth;
+        _savedAdaptiveSampling = params.AdaptiveScreenSampling;
+        _savedRaytracing = _isRaytracing;
+
+        // path tracing runs on the ray tracer, the previous method is restored afterwards
+        _isRaytracing = true;
+        params.Method = Graphic3d_RM_RAYTRACING;
+        params.IsGlobalIlluminationEnabled = Standard_True;
+        params.RaytracingDepth = _progressiveSettings.raytracingDepth;
+        params.AdaptiveScreenSampling = _progressiveSettings.adaptiveSampling;
+        _accumulatedSamples = 0;
+    }
+    else
+    {
+        _accumulationTimer.stop();
+        _isRaytracing = _savedRaytracing;
+        params.Method = _isRaytracing ? Graphic3d_RM_RAYTRACING : Graphic3d_RM_RASTERIZATION;
+        params.IsGlobalIlluminationEnabled = _savedGlobalIllumination;
+        params.RaytracingDepth = _savedRaytracingDepth;
+        params.AdaptiveScreenSampling = _savedAdaptiveSampling;
+    }
+
+    _isProgressive = isEnabled;
+    _view->Invalidate();
+    updateView();
+}
+
+
+void occView::onFrameAccumulated()
+{
+    // any camera change or gesture restarts the accumulation
+    const Graphic3d_WorldViewProjState state = _view->Camera()->WorldViewProjState();
+    if (_isInteracting || _accumulatedSamples == 0 || state != _accumulationState)
+    {
+        _accumulationState = state;
+        _accumulatedSamples = _isInteracting ? 0 : 1;
+        _accumulationClock.start();
+        _sampleReportClock.start();
+    }
+    else
+        ++_accumulatedSamples;
+
+    if (_isInteracting)
+        return;
+
+    const bool isConverged = _accumulatedSamples >= _progressiveSettings.maxSamples;
+    if (_sampleReportClock.elapsed() >= 500 || isConverged)
+    {
+        _sampleReportClock.restart();
+
+        Standard_Integer width = 0;
+        Standard_Integer height = 0;
+        _view->Window()->Size(width, height);
+        const qint64 msecs = qMax<qint64>(1, _accumulationClock.elapsed());
+        const double pixels = double(width) * height * _view->RenderingParams().RenderResolutionScale
+                * _view->RenderingParams().RenderResolutionScale;
+        emit progressiveSamplesChanged(_accumulatedSamples, pixels * _accumulatedSamples * 1000.0 / msecs);
+    }
+
+    if (!isConverged)
+        _accumulationTimer.start();
+}
+
+
+void occView::setStatisticsVisible(bool isVisible)
+{
+    if (!isInitialized())
+        return;
+
+    if (!_statsOverlay)
+    {
+        if (!isVisible)
+            return;
+
+        _statsOverlay = new occStatsOverlay(_context, _view, this);
+        connect(_statsOverlay, &occStatsOverlay::changed, this, [this] {
+            updateView();
+            _isOverlayRefresh = true;
+        });
+    }
+    _statsOverlay->setVisible(isVisible);
+}
+
+
+bool occView::isStatisticsVisible() const
+{
+    return _statsOverlay && _statsOverlay->isVisible();
+}
+
+
+void occView::exportHighResolutionImage()
+{
+    if (!isInitialized())
+        return;
+
+    // default to four times the window resolution
+    const QSize defaultSize = size() * devicePixelRatioF() * 4;
+    bool ok = false;
+    const QString sizeText = QInputDialog::getText(this, "Export image", "Image size (width x height):",
+                                                   QLineEdit::Normal,
+                                                   QString("%1x%2").arg(defaultSize.width()).arg(defaultSize.height()),
+                                                   &ok);
+    if (!ok)
+        return;
+
+    const QStringList sizes = sizeText.split('x', Qt::SkipEmptyParts, Qt::CaseInsensitive);
+    occTiledExportSettings settings;
+    settings.width = sizes.value(0).trimmed().toInt();
+    settings.height = sizes.value(1).trimmed().toInt();
+    if (sizes.size() != 2 || settings.width <= 0 || settings.height <= 0)
+    {
+        QMessageBox::warning(this, "Export image", QString("Invalid image size %1").arg(sizeText));
+        return;
+    }
+
+    settings.fileName = QFileDialog::getSaveFileName(this, "Export image", "occQt6.png",
+                                                     "PNG image (*.png);;TIFF image (*.tif *.tiff)");
+    if (settings.fileName.isEmpty())
+        return;
+
+    QProgressDialog progressDialog("Rendering tiles...", "Cancel", 0, 100, this);
+    progressDialog.setWindowModality(Qt::WindowModal);
+    progressDialog.setMinimumDuration(0);
+
+    // the progress dialog processes events while the camera holds a tile,
+    // the window must not be repainted and no timer may touch the view until the export is done
+    _accumulationTimer.stop();
+    _hoverTimer.stop();
+    _isExporting = true;
+
+    occTiledImageExporter exporter(_view);
+    const bool isDone = exporter.exportImage(settings, [&progressDialog](int percent) {
+        progressDialog.setValue(percent);
+        return !progressDialog.wasCanceled();
+    });
+    const bool isCancelled = progressDialog.wasCanceled();
+    progressDialog.reset();
+
+    _isExporting = false;
+    _view->Invalidate();
+    updateView();
+
+    const QString report = exporter.report().toString(settings);
+    emit highResolutionImageExported(settings.fileName, report);
+    if (!isDone && !isCancelled)
+        QMessageBox::warning(this, "Export image", report);
+}
+
+
 void occView::setRaytracedAntialiasing(bool state)
 {
+    if (!isInitialized())
+        return;
+
     _view->ChangeRenderingParams().IsAntialiasingEnabled = state;
     _isAntialiasingEnabled = state;
     _context->UpdateCurrentViewer();
@@ -296,16 +835,43 @@ void occView::setRaytracedAntialiasing(bool state)
 
 void occView::enableRaytracing()
 {
+    // init() switches the view to ray tracing later
+    if (!isInitialized())
+    {
+        _isRaytracing = true;
+        return;
+    }
+
+    _accumulationTimer.stop();
+    setProgressiveRendering(false);
+    endInteraction();
     if (!_isRaytracing)
         _view->ChangeRenderingParams().Method = Graphic3d_RM_RAYTRACING;
 
 
     _isRaytracing = true;
-    _context->UpdateCurrentViewer();
+
+    // the first raytraced frame compiles the ray tracing programs
+    if (!_isRaytracingCompiled)
+    {
+        _isRaytracingCompiled = true;
+        occShaderCache::measure("first raytraced frame", [this] {_context->UpdateCurrentViewer();});
+    }
+    else
+        _context->UpdateCurrentViewer();
 }
 
 void occView::disableRaytracing()
 {
+    if (!isInitialized())
+    {
+        _isRaytracing = false;
+        return;
+    }
+
+    _accumulationTimer.stop();
+    setProgressiveRendering(false);
+    endInteraction();
     if (_isRaytracing)
         _view->ChangeRenderingParams().Method = Graphic3d_RM_RASTERIZATION;
 
@@ -597,12 +1163,17 @@ void occView::mousePressEvent(QMouseEvent* event)
 
 void occView::mouseReleaseEvent(QMouseEvent* event)
 {
+    if (!isInitialized())
+        return;
+
     Graphic3d_Vec2i point;
     point.SetValues(_devPx*event->pos().x(), _devPx*event->pos().y());
     const Aspect_VKeyFlags flags = qtMouseModifiers2VKeys(event->modifiers());
     if (!_view.IsNull() && UpdateMouseButtons(point, qtMouseButtons2VKeys(event->buttons()), flags, false))
         updateView();
 
+    if (_isInteracting && event->buttons() == Qt::NoButton)
+        _restoreQualityTimer.start(_interactionQuality.restoreDelay);
 
     if (_curMode == occViewEnums::curAction3d::GlobalPanning)
         _view->Place(point.x(), point.y(), _curZoom);
@@ -619,6 +1190,10 @@ void occView::mouseMoveEvent(QMouseEvent* event)
 {
     Graphic3d_Vec2i point;
     point.SetValues(_devPx*event->pos().x(), _devPx*event->pos().y());
+    // dragging with a button pressed navigates the view
+    if (!_view.IsNull() && event->buttons() != Qt::NoButton && (_clickPos - point).cwiseAbs().maxComp() > 4)
+        beginInteraction();
+
     if (!_view.IsNull() && UpdateMousePosition(point, qtMouseButtons2VKeys(event->buttons()), qtMouseModifiers2VKeys(event->modifiers()), false))
         updateView();
 }
@@ -637,13 +1212,126 @@ void occView::wheelEvent(QWheelEvent* event)
     else if (numDegrees != 0)
         delta = numDegrees / 15;
 
+    if (!_view.IsNull())
+    {
+        beginInteraction();
+        _restoreQualityTimer.start(_interactionQuality.restoreDelay);
+    }
+
     if (!_view.IsNull() && UpdateZoom(Aspect_ScrollDelta(pos, delta)))
         updateView();
 }
 
+
+void occView::beginInteraction()
+{
+    _restoreQualityTimer.stop();
+    if (_isInteracting)
+        return;
+
+    // path tracing is always too slow while moving, other modes only above the threshold
+    if (!_isProgressive && (!_interactionQuality.isEnabled || _renderMsecs < _interactionQuality.frameTimeThreshold))
+        return;
+
+    _isInteracting = true;
+
+    Graphic3d_RenderingParams& params = _view->ChangeRenderingParams();
+    _savedMsaaSamples = params.NbMsaaSamples;
+    _savedResolutionScale = params.RenderResolutionScale;
+    _savedRenderingMethod = params.Method;
+
+    params.NbMsaaSamples = 0;
+    if (_isProgressive)
+        params.RenderResolutionScale = _progressiveSettings.interactiveScale;
+    else
+    {
+        params.Method = Graphic3d_RM_RASTERIZATION;
+        params.RenderResolutionScale = _interactionQuality.resolutionScale;
+    }
+
+    if (_interactionQuality.dropFaceBoundaries)
+    {
+        // The boundaries get an empty line type, the presentations are only synchronized.
+        // Shapes displayed during the gesture share the aspects and are restored with them.
+        AIS_ListOfInteractive objects;
+        _context->DisplayedObjects(objects);
+        for (const auto& object : objects)
+        {
+            const Handle(Prs3d_Drawer)& drawer = object->Attributes();
+            if (!drawer->FaceBoundaryDraw())
+                continue;
+
+            const Handle(Graphic3d_AspectLine3d)& aspect = drawer->FaceBoundaryAspect()->Aspect();
+            if (!_hiddenFaceBoundaries.contains(aspect.get()))
+            {
+                _hiddenFaceBoundaries.insert(aspect.get(), {aspect, aspect->LineType()});
+                aspect->SetLineType(Aspect_TOL_EMPTY);
+            }
+            object->SynchronizeAspects();
+        }
+    }
+}
+
+
+void occView::endInteraction()
+{
+    if (!_isInteracting)
+        return;
+
+    _isInteracting = false;
+
+    Graphic3d_RenderingParams& params = _view->ChangeRenderingParams();
+    params.NbMsaaSamples = _savedMsaaSamples;
+    params.RenderResolutionScale = _savedResolutionScale;
+    params.Method = _savedRenderingMethod;
+
+    if (!_hiddenFaceBoundaries.isEmpty())
+    {
+        for (const auto& hidden : qAsConst(_hiddenFaceBoundaries))
+            hidden.aspect->SetLineType(hidden.lineType);
+
+        // includes the shapes displayed during the gesture
+        AIS_ListOfInteractive objects;
+        _context->DisplayedObjects(objects);
+        for (const auto& object : objects)
+        {
+            const Handle(Prs3d_Drawer)& drawer = object->Attributes();
+            if (drawer->FaceBoundaryDraw() && _hiddenFaceBoundaries.contains(drawer->FaceBoundaryAspect()->Aspect().get()))
+                object->SynchronizeAspects();
+        }
+        _hiddenFaceBoundaries.clear();
+    }
+
+    updateView();
+}
+
 void occView::updateView()
 {
+    // any other update is a frame of the scene
+    _isOverlayRefresh = false;
+
+    // a frame was presented recently, fold this event into the next one
+    if (_frameTimer.isActive())
+    {
+        ++_pendingInputEvents;
+        return;
+    }
+
+    this->update();
+    _frameTimer.start();
+}
+
+void occView::onFrameTick()
+{
+    if (_pendingInputEvents == 0)
+        return;
+
+    // all pending events are handled by a single viewer flush
+    _foldedInputEvents += _pendingInputEvents - 1;
+    _pendingInputEvents = 0;
+
     this->update();
+    _frameTimer.start();
 }
 
 
@@ -674,6 +1362,7 @@ void occView::defineMouseGestures()
         break;
     case occViewEnums::curAction3d::Selecting:
         myMouseGestureMap.Bind(Aspect_VKeyMouse_LeftButton, AIS_MouseGesture_SelectRectangle);
+        myMouseGestureMap.Bind(Aspect_VKeyMouse_LeftButton | Aspect_VKeyFlags_ALT, AIS_MouseGesture_SelectLasso);
         break;
     }
 }
@@ -711,11 +1400,17 @@ void occView::popup(int /*x*/, int /*y*/)
     }
     else
     {
-        auto contextMenu = occViewContextMenu(nullptr, _curDrawStyle);
+        auto contextMenu = occViewContextMenu(nullptr, _curDrawStyle, isStatisticsVisible(), _isProgressive,
+                                              selectionMode());
 
         //connections
         connect(&contextMenu, &occViewContextMenu::fitAll, this, &occView::fitAll);
         connect(&contextMenu, &occViewContextMenu::fitArea, this, &occView::fitArea);
+        connect(&contextMenu, &occViewContextMenu::showStatistics, this, &occView::setStatisticsVisible);
+        connect(&contextMenu, &occViewContextMenu::progressiveRendering, this, &occView::setProgressiveRendering);
+        connect(&contextMenu, &occViewContextMenu::selectionMode, this, &occView::setSelectionMode);
+        connect(&contextMenu, &occViewContextMenu::saveImage, this, qOverload<>(&occView::saveImage));
+        connect(&contextMenu, &occViewContextMenu::exportImage, this, &occView::exportHighResolutionImage);
         connect(&contextMenu, &occViewContextMenu::axo, this, &occView::axo);
         connect(&contextMenu, &occViewContextMenu::front, this, &occView::front);
         connect(&contextMenu, &occViewContextMenu::back, this, &occView::back);
@@ -791,6 +1486,9 @@ void occView::addItemInPopup(QMenu* /* menu */)
 
 void occView::onBackground()
 {
+    if (!isInitialized())
+        return;
+
     QColor aColor ;
     Standard_Real R1;
     Standard_Real G1;
@@ -813,6 +1511,9 @@ void occView::onBackground()
 
 void occView::onEnvironmentMap()
 {
+    if (!isInitialized())
+        return;
+
     if (_backMenu->actions().at(1)->isChecked())
     {
         QString fileName = QFileDialog::getOpenFileName(this, tr("Open File"), "",
@@ -830,6 +1531,60 @@ void occView::onEnvironmentMap()
     _view->Redraw();
 }
 
+void occView::applyViewPreset(const Handle(V3d_View)& view, occViewEnums::viewAction preset)
+{
+    // the view does not exist before the deferred init()
+    if (view.IsNull())
+        return;
+
+    switch (preset)
+    {
+    case occViewEnums::viewFront:
+        view->SetProj(V3d_Yneg);
+        break;
+    case occViewEnums::viewBack:
+        view->SetProj(V3d_Ypos);
+        break;
+    case occViewEnums::viewTop:
+        view->SetProj(V3d_Zpos);
+        break;
+    case occViewEnums::viewBottom:
+        view->SetProj(V3d_Zneg);
+        break;
+    case occViewEnums::viewLeft:
+        view->SetProj(V3d_Xneg);
+        break;
+    case occViewEnums::viewRight:
+        view->SetProj(V3d_Xpos);
+        break;
+    case occViewEnums::viewAxo:
+    default:
+        view->SetProj(V3d_XposYnegZpos);
+        break;
+    }
+    view->FitAll();
+}
+
+bool occView::viewPresetFromName(const QString& name, occViewEnums::viewAction& preset)
+{
+    static const QMap<QString, occViewEnums::viewAction> presets {
+        {"front", occViewEnums::viewFront},
+        {"back", occViewEnums::viewBack},
+        {"top", occViewEnums::viewTop},
+        {"bottom", occViewEnums::viewBottom},
+        {"left", occViewEnums::viewLeft},
+        {"right", occViewEnums::viewRight},
+        {"axo", occViewEnums::viewAxo}
+    };
+
+    auto it = presets.constFind(name.toLower());
+    if (it == presets.constEnd())
+        return false;
+
+    preset = it.value();
+    return true;
+}
+
 bool occView::dump(Standard_CString file)
 {
     return _view->Dump(file);
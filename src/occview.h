@@ -12,18 +12,54 @@
 
 // Qt headers
 #include <Standard_WarningsDisable.hxx>
+#include <QElapsedTimer>
+#include <QHash>
 #include <QMenu>
+#include <QTimer>
 #include <QWidget>
 #include <Standard_WarningsRestore.hxx>
 
 // occt headers
 #include <AIS_InteractiveContext.hxx>
 #include <AIS_ViewController.hxx>
+#include <Graphic3d_AspectLine3d.hxx>
 #include <V3d_View.hxx>
 
 //project headers
 #include "occviewenums.h"
 
+class occAreaSelector;
+class occImageExporter;
+class occSelectionModes;
+class occStatsOverlay;
+
+// Rendering quality while the user navigates the view with the mouse
+struct occInteractionQuality
+{
+    bool isEnabled {true};
+    double frameTimeThreshold {20.0};   // reduce quality only if full quality frames take longer (ms)
+    float resolutionScale {1.0f};       // render resolution while navigating, e.g. 0.5 for half
+    bool dropFaceBoundaries {false};    // hide face boundaries through their line aspects, no recomputation
+    int restoreDelay {300};             // full quality is restored this long after the gesture (ms)
+};
+
+// Progressive path tracing, samples accumulate while the camera rests
+struct occProgressiveSettings
+{
+    int raytracingDepth {4};
+    bool adaptiveSampling {true};       // spend samples on noisy pixels first
+    float interactiveScale {0.5f};      // render resolution while navigating
+    int maxSamples {1024};              // samples per pixel after which accumulation stops
+};
+
+// Dynamic highlighting of the object under the mouse
+struct occHoverSettings
+{
+    bool isEnabled {true};
+    double maxRate {30.0};              // picks per second, moves in between only update the pending position
+    bool skipDuringGestures {true};     // no picking while a mouse button is down or the view navigates
+};
+
 class TopoDS_Shape;
 
 class occView : public QWidget, protected AIS_ViewController
@@ -41,7 +77,10 @@ public:
     //explicit occView(QWidget *parent = nullptr);
     //const Handle(AIS_InteractiveContext)& getContext() const { return _context;}
 
+    // Creates the graphic driver, viewer and view. Called on the first paint
+    // unless OCCQT6_EAGER_INIT is set, emits viewerInitialized() when done.
     void init();
+    bool isInitialized() const {return !_view.IsNull();}
     bool dump (Standard_CString file);
 
 //    void noActiveActions();
@@ -59,28 +98,80 @@ public:
     bool isReflectionsEnabled() const {return _isReflectionsEnabled;}
     bool isAntialiasingEnabled() const {return _isAntialiasingEnabled;}
 
+    bool isStatisticsVisible() const;
+
+    // reduced quality during mouse gestures on scenes that render slowly
+    void setInteractionQuality(const occInteractionQuality& quality) {_interactionQuality = quality;}
+    const occInteractionQuality& interactionQuality() const {return _interactionQuality;}
+    bool isInteracting() const {return _isInteracting;}
+
+    void setProgressiveSettings(const occProgressiveSettings& settings) {_progressiveSettings = settings;}
+    const occProgressiveSettings& progressiveSettings() const {return _progressiveSettings;}
+    bool isProgressiveRendering() const {return _isProgressive;}
+
+    void setHoverSettings(const occHoverSettings& settings) {_hoverSettings = settings;}
+    const occHoverSettings& hoverSettings() const {return _hoverSettings;}
+
+    // hover picks performed, time spent in them and mouse moves that did not pick
+    quint64 hoverPicks() const {return _hoverPicks;}
+    double hoverPickMsecs() const {return _hoverPickMsecs;}
+    quint64 skippedHoverPicks() const {return _skippedHoverPicks;}
+
+    // number of input events that were folded into an already scheduled frame
+    quint64 foldedInputEvents() const {return _foldedInputEvents;}
+
+    // Scene transactions: between beginScene() and commitScene() display, erase and
+    // attribute changes only mark the scene dirty. The outermost commit performs a
+    // single viewer update and, if requested by fit or fitAll(), a single fit.
+    void beginScene();
+    void commitScene(bool fit = true);
+    bool isInScene() const {return _sceneDepth > 0;}
+
+    void display(const Handle(AIS_InteractiveObject)& object);
+    void erase(const Handle(AIS_InteractiveObject)& object);
+    void remove(const Handle(AIS_InteractiveObject)& object);   // erases and forgets the object
+
+    // Per-object styling. Objects may share their drawer through occStyleRegistry,
+    // these detach the object first so that only this object changes.
+    void setColor(const Handle(AIS_InteractiveObject)& object, const Quantity_Color& color);
+    void setDisplayMode(const Handle(AIS_InteractiveObject)& object, int mode);
+    void setTransparency(const Handle(AIS_InteractiveObject)& object, double transparency);
+    void setMaterial(const Handle(AIS_InteractiveObject)& object, const Graphic3d_MaterialAspect& material);
+    void setWidth(const Handle(AIS_InteractiveObject)& object, double width);
+
     static QString getMessages(int type,
                                TopAbs_ShapeEnum subShapeType,
                                TopAbs_ShapeEnum shapeType);
     static QString getShapeType(TopAbs_ShapeEnum shapeType);
 
-    Standard_EXPORT static void onButtonUserAction(int ExerciseSTEP, Handle(AIS_InteractiveContext)& );
-    Standard_EXPORT static void doSelection(int Id, Handle(AIS_InteractiveContext)& );
-    Standard_EXPORT static void onSetSelectionMode(Handle(AIS_InteractiveContext)&,
-                                                   Standard_Integer&,
-                                                   TopAbs_ShapeEnum& SelectionMode,
-                                                   Standard_Boolean& );
+    // Standard view presets (front, top, axo, ...), shared with offscreen views.
+    // Sets the projection of the view and fits all objects into it.
+    static void applyViewPreset(const Handle(V3d_View)& view, occViewEnums::viewAction preset);
+    static bool viewPresetFromName(const QString& name, occViewEnums::viewAction& preset);
+
+    // objects are displayed without selection, the current mode is activated lazily
+    TopAbs_ShapeEnum selectionMode() const;
 
     //getters
     const Handle(V3d_View)& getView() const {return _view;}
     const Handle(AIS_InteractiveContext)& getContext() const {return _context;};
     const Handle(Graphic3d_Structure)& getStruct() const {return _struct;}
+    occImageExporter* getImageExporter() const {return _imageExporter;}
+    occSelectionModes* getSelectionModes() const {return _selectionModes;}
+    occAreaSelector* getAreaSelector() const {return _areaSelector;}
 
     //QList<QAction*>* getViewActions();
     QList<QAction*>* getRaytraceActions();
 
 signals:
     void selectionChanged();
+    void viewerInitialized();
+
+    // samples per pixel accumulated by progressive path tracing and the sample rate
+    void progressiveSamplesChanged(int samplesPerPixel, double samplesPerSecond);
+
+    // a high resolution export finished, was cancelled or failed, the report includes the throughput
+    void highResolutionImageExported(const QString& fileName, const QString& report);
 
 public slots:
     // mouse operations
@@ -88,18 +179,18 @@ public slots:
     void select() {setCurAction(occViewEnums::curAction3d::Selecting);}
     void zoom() {setCurAction(occViewEnums::curAction3d::DynamicZooming);}
     void pan() {setCurAction(occViewEnums::curAction3d::DynamicPanning);}
-    void globalPan() { _curZoom = _view->Scale(); _view->FitAll(); setCurAction(occViewEnums::curAction3d::GlobalPanning);}
+    void globalPan() { if (!isInitialized()) return; _curZoom = _view->Scale(); _view->FitAll(); setCurAction(occViewEnums::curAction3d::GlobalPanning);}
     void rotation() {setCurAction(occViewEnums::curAction3d::DynamicRotation);}
     //standard views
-    void front() {_view->SetProj(V3d_Yneg);_view->FitAll();}
-    void back() {_view->SetProj(V3d_Ypos);_view->FitAll();}
-    void top() {_view->SetProj(V3d_Zpos);_view->FitAll();}
-    void bottom() {_view->SetProj(V3d_Zneg);_view->FitAll();}
-    void left() {_view->SetProj(V3d_Xneg);_view->FitAll();}
-    void right() {_view->SetProj(V3d_Xpos);_view->FitAll();}
-    void axo() {_view->SetProj(V3d_XposYnegZpos); _view->FitAll();}
+    void front() {applyViewPreset(_view, occViewEnums::viewFront);}
+    void back() {applyViewPreset(_view, occViewEnums::viewBack);}
+    void top() {applyViewPreset(_view, occViewEnums::viewTop);}
+    void bottom() {applyViewPreset(_view, occViewEnums::viewBottom);}
+    void left() {applyViewPreset(_view, occViewEnums::viewLeft);}
+    void right() {applyViewPreset(_view, occViewEnums::viewRight);}
+    void axo() {applyViewPreset(_view, occViewEnums::viewAxo);}
     // fit to screen or selections
-    void fitAll() { _view->FitAll(); _view->ZFitAll(); _view->Redraw();}
+    void fitAll();
     void fitArea() {setCurAction(occViewEnums::curAction3d::WindowZooming);}
     void reset() {axo();};
 
@@ -115,6 +206,22 @@ public slots:
     void onEnvironmentMap();
     void onRaytraceAction();
 
+    // select whole objects (TopAbs_SHAPE) or solids, faces, edges or vertices of shapes
+    void setSelectionMode(TopAbs_ShapeEnum shapeType);
+
+    // path tracing that refines the image while the camera rests
+    void setProgressiveRendering(bool isEnabled);
+
+    // rendering statistics and frame time histogram on top of the view
+    void setStatisticsVisible(bool isVisible);
+
+    // save a screenshot in the background, the dialog version asks for the file name
+    void saveImage();
+    bool saveImage(const QString& fileName, int quality = -1);
+
+    // render the view in tiles into an image larger than the window
+    void exportHighResolutionImage();
+
 
 protected:
     virtual QPaintEngine* paintEngine() const override;
@@ -151,12 +258,25 @@ protected:
     void OnSelectionChanged (const Handle(AIS_InteractiveContext)& theCtx,
                              const Handle(V3d_View)& theView) Standard_OVERRIDE;
 
+    // Rate limited hover picking, skipped during gestures.
+    void handleDynamicHighlight (const Handle(AIS_InteractiveContext)& theCtx,
+                                 const Handle(V3d_View)& theView) Standard_OVERRIDE;
+
+    // Rectangle and lasso selection run on the area selector.
+    void handleSelectionPoly (const Handle(AIS_InteractiveContext)& theCtx,
+                              const Handle(V3d_View)& theView) Standard_OVERRIDE;
+
+    // Request the next frame if the view controller is still animating.
+    void handleViewRedraw (const Handle(AIS_InteractiveContext)& theCtx,
+                           const Handle(V3d_View)& theView) Standard_OVERRIDE;
+
 private:
 
     bool _isRaytracing {false};
     bool _isShadowsEnabled {true};
     bool _isReflectionsEnabled {false};
     bool _isAntialiasingEnabled {false};
+    bool _isRaytracingCompiled {false};
 
     const Standard_Real _devPx;
 
@@ -183,9 +303,101 @@ private:
     QList<QAction*>* _raytraceActions {0};
     QMenu* _backMenu {nullptr};
 
+    // frame pacing: input arriving between two frames is flushed once per frame
+    QTimer _frameTimer;
+    quint64 _pendingInputEvents {0};
+    quint64 _foldedInputEvents {0};
+
+    void onFrameTick();
+
+    // screenshots are encoded on worker threads
+    occImageExporter* _imageExporter;
+    QString _imageFileName {"occQt6.png"};
+
+    // interaction quality, the saved parameters are restored after the gesture
+    occInteractionQuality _interactionQuality;
+    bool _isInteracting {false};
+    double _renderMsecs {0.0};
+    QTimer _restoreQualityTimer;
+    int _savedMsaaSamples {0};
+    float _savedResolutionScale {1.0f};
+    Graphic3d_RenderingMode _savedRenderingMethod {Graphic3d_RM_RASTERIZATION};
+
+    // face boundary aspects hidden during the gesture with their line type
+    struct hiddenAspect
+    {
+        Handle(Graphic3d_AspectLine3d) aspect;
+        Aspect_TypeOfLine lineType;
+    };
+    QHash<const Graphic3d_AspectLine3d*, hiddenAspect> _hiddenFaceBoundaries;
+
+    void beginInteraction();
+    void endInteraction();
+
+    // progressive path tracing state
+    occProgressiveSettings _progressiveSettings;
+    bool _isProgressive {false};
+    QTimer _accumulationTimer;
+    int _accumulatedSamples {0};
+    QElapsedTimer _accumulationClock;
+    QElapsedTimer _sampleReportClock;
+    Graphic3d_WorldViewProjState _accumulationState;
+    bool _savedGlobalIllumination {false};
+    int _savedRaytracingDepth {3};
+    bool _savedAdaptiveSampling {false};
+    bool _savedRaytracing {false};
+
+    void onFrameAccumulated();
+
+    // hover picking, a deferred pick always uses the latest mouse position
+    occHoverSettings _hoverSettings;
+    QElapsedTimer _hoverClock;
+    QTimer _hoverTimer;
+    Graphic3d_Vec2i _hoverPoint;
+    quint64 _hoverPicks {0};
+    quint64 _skippedHoverPicks {0};
+    double _hoverPickMsecs {0.0};
+
+    void onHoverTimer();
+
+    // selection modes are activated and their BVH built in the background
+    occSelectionModes* _selectionModes {nullptr};
+    occAreaSelector* _areaSelector {nullptr};
+
+    // created when the statistics are shown for the first time
+    occStatsOverlay* _statsOverlay {nullptr};
+    bool _isOverlayRefresh {false};     // the pending repaint only shows new overlay text
+
+    // deferred initialization
+    bool _isInitScheduled {false};
+    bool _isFirstFrameDone {false};
+
+    // repaints are suppressed while a tiled export has moved the camera
+    bool _isExporting {false};
+
+    // scene transaction state
+    int _sceneDepth {0};
+    bool _isSceneDirty {false};
+    bool _isFitPending {false};
+
     void initCursors();
 //    void initViewActions();
     void initRaytraceActions();
 };
 
+// Opens a scene transaction on construction and commits it on destruction.
+class occSceneTransaction
+{
+public:
+    explicit occSceneTransaction(occView* view, bool fit = true) : _view(view), _fit(fit) {_view->beginScene();}
+    ~occSceneTransaction() {_view->commitScene(_fit);}
+
+    occSceneTransaction(const occSceneTransaction&) = delete;
+    occSceneTransaction& operator=(const occSceneTransaction&) = delete;
+
+private:
+    occView* _view;
+    bool _fit;
+};
+
 #endif // OCCVIEW_H
@@ -7,9 +7,13 @@
 #include "hirespixmap.h"
 
 occViewContextMenu::occViewContextMenu(QWidget *parent,
-                                       occViewEnums::drawStyle drawStyle)
+                                       occViewEnums::drawStyle drawStyle,
+                                       bool isStatisticsVisible,
+                                       bool isProgressive,
+                                       TopAbs_ShapeEnum selectionMode)
     : QMenu(parent),
-      _curDrawStyle(drawStyle)
+      _curDrawStyle(drawStyle),
+      _selectionMode(selectionMode)
 {
     _iconHeight = QProxyStyle().pixelMetric(QStyle::PM_SmallIconSize, 0, 0);
 
@@ -33,6 +37,40 @@ occViewContextMenu::occViewContextMenu(QWidget *parent,
 
     auto drawMenu = this->addMenu("Draw style");
     addDrawStyles(*drawMenu);
+
+    auto selectMenu = this->addMenu("Select");
+    selectMenu->setIcon(hiresPixmap(":/icons/lucide/box-select.svg", _iconHeight));
+    addSelectionModes(*selectMenu);
+
+    this->addSeparator();
+    a = new QAction("Path tracing", this );
+    a->setToolTip("Refine the image with progressive path tracing while the view rests");
+    a->setIcon(hiresPixmap(":/icons/lucide/globe.svg", _iconHeight));
+    a->setCheckable(true);
+    a->setChecked(isProgressive);
+    connect(a, &QAction::toggled, this, &occViewContextMenu::progressiveRendering);
+    this->addAction(a);
+
+    a = new QAction("Show statistics", this );
+    a->setToolTip("Show frame statistics and a frame time histogram");
+    a->setIcon(hiresPixmap(":/icons/lucide/activity.svg", _iconHeight));
+    a->setCheckable(true);
+    a->setChecked(isStatisticsVisible);
+    connect(a, &QAction::toggled, this, &occViewContextMenu::showStatistics);
+    this->addAction(a);
+
+    this->addSeparator();
+    a = new QAction("Save image...", this );
+    a->setToolTip("Save the view as an image in the background");
+    a->setIcon(hiresPixmap(":/icons/lucide/save.svg", _iconHeight));
+    connect(a, &QAction::triggered, this, &occViewContextMenu::saveImage);
+    this->addAction(a);
+
+    a = new QAction("Export image...", this );
+    a->setToolTip("Export a high resolution image of the view");
+    a->setIcon(hiresPixmap(":/icons/lucide/save.svg", _iconHeight));
+    connect(a, &QAction::triggered, this, &occViewContextMenu::exportImage);
+    this->addAction(a);
 }
 
 
@@ -133,3 +171,28 @@ void occViewContextMenu::addDrawStyles(QMenu &drawMenu)
     drawMenu.addAction(shaded);
     drawMenu.addAction(shadedWEdges);
 }
+
+
+void occViewContextMenu::addSelectionModes(QMenu &selectMenu)
+{
+    const QList<QPair<QString, TopAbs_ShapeEnum>> modes {
+        {"Objects", TopAbs_SHAPE},
+        {"Solids", TopAbs_SOLID},
+        {"Faces", TopAbs_FACE},
+        {"Edges", TopAbs_EDGE},
+        {"Vertices", TopAbs_VERTEX}
+    };
+
+    auto group = new QActionGroup(this);
+    for (const auto& mode : modes)
+    {
+        auto a = new QAction(mode.first, this);
+        a->setToolTip(QString("Select %1").arg(mode.first.toLower()));
+        a->setCheckable(true);
+        a->setChecked(mode.second == _selectionMode);
+        const TopAbs_ShapeEnum shapeType = mode.second;
+        connect(a, &QAction::triggered, this, [this, shapeType] { emit selectionMode(shapeType); });
+        group->addAction(a);
+        selectMenu.addAction(a);
+    }
+}
@@ -3,6 +3,8 @@
 
 #include <QMenu>
 
+#include <TopAbs_ShapeEnum.hxx>
+
 #include "occviewenums.h"
 
 class occViewContextMenu : public QMenu
@@ -10,12 +12,20 @@ class occViewContextMenu : public QMenu
     Q_OBJECT
 public:
     explicit occViewContextMenu(QWidget *parent,
-                                occViewEnums::drawStyle drawStyle);
+                                occViewEnums::drawStyle drawStyle,
+                                bool isStatisticsVisible = false,
+                                bool isProgressive = false,
+                                TopAbs_ShapeEnum selectionMode = TopAbs_SHAPE);
     ~occViewContextMenu() = default;
 
 signals:
     void fitAll();
     void fitArea();
+    void showStatistics(bool isVisible);
+    void progressiveRendering(bool isEnabled);
+    void selectionMode(TopAbs_ShapeEnum shapeType);
+    void saveImage();
+    void exportImage();
 
     // view actions
     void axo();
@@ -37,7 +47,9 @@ private:
 
     int _iconHeight;
     occViewEnums::drawStyle _curDrawStyle;
+    TopAbs_ShapeEnum _selectionMode;
     void addViewActions(QMenu &viewMenu);
+    void addSelectionModes(QMenu &selectMenu);
     void addDrawStyles(QMenu &drawMenu);
 };
 
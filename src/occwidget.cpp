@@ -28,31 +28,39 @@
 
 #include "occwidget.h"
 
+// std headers
+#include <cmath>
+
 // Qt headers
 #include <Standard_WarningsDisable.hxx>
 #include <QAction>
+#include <QApplication>
 #include <QCloseEvent>
+#include <QDebug>
+#include <QElapsedTimer>
 #include <QEvent>
+#include <QFileInfo>
+#include <QFileDialog>
+#include <QInputDialog>
 #include <QMessageBox>
+#include <QStandardPaths>
 #include <QToolBar>
 #include <QToolButton>
 #include <QVBoxLayout>
 #include <Standard_WarningsRestore.hxx>
 
 // occ headers
+#include <AIS_Triangulation.hxx>
 #include <Standard_Version.hxx>
 
 #include <gp_Circ.hxx>
 #include <gp_Elips.hxx>
 #include <gp_Lin2d.hxx>
 #include <gp_Pln.hxx>
+#include <gp_Trsf.hxx>
 
 #include <BRepLib.hxx>
 
-#include <BRepAlgoAPI_Common.hxx>
-#include <BRepAlgoAPI_Cut.hxx>
-#include <BRepAlgoAPI_Fuse.hxx>
-
 #include <BRepBuilderAPI.hxx>
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepBuilderAPI_MakeFace.hxx>
@@ -76,6 +84,8 @@
 #include <BRepPrimAPI_MakePrism.hxx>
 #include <BRepPrimAPI_MakeRevol.hxx>
 
+#include <Message_ProgressScope.hxx>
+
 #include <GCE2d_MakeSegment.hxx>
 
 #include <Geom_ConicalSurface.hxx>
@@ -88,11 +98,14 @@
 #include <TopoDS.hxx>
 #include <TopExp.hxx>
 #include <TopExp_Explorer.hxx>
+#include <TopTools_ListIteratorOfListOfShape.hxx>
 
 // private headers
 #include "customtoolbutton.h"
 #include "emptyspacerwidget.h"
 #include "hirespixmap.h"
+#include "occimageexporter.h"
+#include "occstartupprofiler.h"
 
 occWidget::occWidget(QWidget *parent)
     : QWidget(parent)
@@ -108,8 +121,30 @@ occWidget::occWidget(QWidget *parent)
     _occView = new occView(this);
     layout->addWidget(_occView);
 
+    _statusBar = new QStatusBar;
+    layout->addWidget(_statusBar);
+
+    _mesher = new occMesher(this);
+    _jobEngine = new occJobEngine(_mesher, this);
+    _benchmark = new occBenchmark(_occView, this);
+    _recorder = new occTurntableRecorder(_occView, this);
+    _stepImporter = new occStepImporter(_mesher, this);
+    _stlReader = new occStlReader(this);
+    _instancer = new occInstancer(_occView, _mesher, this);
+
     this->setLayout(layout);
     this->populateToolBar();
+    occStartupProfiler::mark("toolbar populated");
+    this->populateStatusBar();
+
+    // the toolbar works on the viewer, which is created after the window is shown
+    if (_occView->isInitialized())
+        onViewerInitialized();
+    else
+    {
+        _toolBar->setEnabled(false);
+        connect(_occView, &occView::viewerInitialized, this, &occWidget::onViewerInitialized);
+    }
 
     // show and force size update to redraw occt window
     this->show();
@@ -125,6 +160,23 @@ occWidget::occWidget(QWidget *parent)
 // ------------------------------------------------------------------------------------------------
 // private functions
 // ------------------------------------------------------------------------------------------------
+void occWidget::onViewerInitialized()
+{
+    _mesher->setDrawer(_occView->getContext()->DefaultDrawer());
+    _styles.setDefaultDrawer(_occView->getContext()->DefaultDrawer());
+
+    // objects can be picked once their selection is prepared
+    const QString selectionMessage {"Preparing selection..."};
+    connect(_occView->getSelectionModes(), &occSelectionModes::busyChanged, this, [this, selectionMessage](bool isBusy) {
+        if (isBusy && _statusBar->currentMessage().isEmpty())
+            _statusBar->showMessage(selectionMessage);
+        else if (!isBusy && _statusBar->currentMessage() == selectionMessage)
+            _statusBar->clearMessage();
+    });
+    _toolBar->setEnabled(true);
+}
+
+
 void occWidget::about()
 {
     QString datetime = QStringLiteral(__DATE__) + QStringLiteral(" ") + QStringLiteral(__TIME__);
@@ -207,6 +259,11 @@ void occWidget::populateToolBar()
     _toolBar->addSeparator();
     auto reset = addActionToToolBar("Reset View", "lucide/reset.svg", "Reset view");// new QAction("Reset View", this);
 
+    // import files
+    _toolBar->addSeparator();
+    auto importStepAction = addActionToToolBar("Import STEP", "lucide/folder-open.svg", "Import a STEP file or assembly");
+    auto importStlAction = addActionToToolBar("Import STL", "lucide/folder-open.svg", "Import a binary or ASCII STL mesh");
+
     // add primitives
     _toolBar->addSeparator();
     auto boxAction = addActionToToolBar("Box", "lucide/box.svg", "Add box");// new QAction("Box", this);
@@ -223,17 +280,24 @@ void occWidget::populateToolBar()
     auto extrudeAction = addActionToToolBar("Extrude", "extrude.svg", "Add extrusion example");
     auto revolAction = addActionToToolBar("Revolve", "revol.svg", "Add revolution example");
     auto loftAction = addActionToToolBar("Loft", "loft.svg", "Add loft example");
+    auto filletInstancesAction = addActionToToolBar("Fillet Instances", "fillet.svg", "Place many copies of the fillet box that share one tessellation");
 
     // boolean operations
     _toolBar->addSeparator();
     auto boolCutAction = addActionToToolBar("Boolean Cut", "boolCut.svg", "Add Boolean cut operation");
     auto boolFuseAction = addActionToToolBar("Boolean Fuse", "boolFuse.svg", "Add Boolean fuse operation");
     auto boolCommonAction = addActionToToolBar("Boolean Common", "boolCommon.svg", "Add Boolean common operation");
+    auto boolCutBatchAction = addActionToToolBar("Boolean Batch Cut", "boolCut.svg", "Cut many holes in a single pass and compare with pairwise cuts");
 
     // draw helices
     _toolBar->addSeparator();
     auto helixAction = addActionToToolBar("Helices", "helix.svg", "add helices example");
 
+    // benchmarks
+    _toolBar->addSeparator();
+    auto stressTestAction = addActionToToolBar("Stress Test", "lucide/activity.svg", "Fill the scene with primitives and measure the frame rate");
+    auto turntableAction = addActionToToolBar("Turntable", "lucide/video.svg", "Record a turntable animation as images or video");
+
     // add about action
     auto about = addActionToToolBar("About", "lucide/info.svg", "About occQt6");
 
@@ -250,6 +314,9 @@ void occWidget::populateToolBar()
 
     connect(reset, &QAction::triggered, _occView, &occView::reset);
 
+    connect(importStepAction, &QAction::triggered, this, &occWidget::importStep);
+    connect(importStlAction, &QAction::triggered, this, &occWidget::importStl);
+
     connect(boxAction, &QAction::triggered, this, &occWidget::addBox);
     connect(coneAction, &QAction::triggered, this, &occWidget::addCone);
     connect(sphereAction, &QAction::triggered, this, &occWidget::addSphere);
@@ -266,23 +333,157 @@ void occWidget::populateToolBar()
     connect(boolCutAction, &QAction::triggered, this, &occWidget::boolCut);
     connect(boolFuseAction, &QAction::triggered, this, &occWidget::boolFuse);
     connect(boolCommonAction, &QAction::triggered, this, &occWidget::boolCommon);
+    connect(boolCutBatchAction, &QAction::triggered, this, &occWidget::boolCutBatch);
+    connect(filletInstancesAction, &QAction::triggered, this, &occWidget::makeFilletInstances);
 
     connect(helixAction, &QAction::triggered, this, &occWidget::testHelix);
 
+    connect(stressTestAction, &QAction::triggered, this, &occWidget::runStressTest);
+    connect(turntableAction, &QAction::triggered, this, &occWidget::recordTurntable);
+
     connect(about, &QAction::triggered, this, &occWidget::about);
 }
 
 
+void occWidget::populateStatusBar()
+{
+    _statusBar->setSizeGripEnabled(false);
+
+    _progressBar = new QProgressBar;
+    _progressBar->setRange(0, 100);
+    _progressBar->setMaximumWidth(200);
+    _progressBar->setTextVisible(false);
+    _progressBar->hide();
+    _statusBar->addPermanentWidget(_progressBar);
+
+    _cancelButton = new QToolButton;
+    _cancelButton->setText("Cancel");
+    _cancelButton->setToolTip("Cancel background operations");
+    _cancelButton->hide();
+    _statusBar->addPermanentWidget(_cancelButton);
+
+    // connections
+    connect(_mesher, &occMesher::progress, _progressBar, &QProgressBar::setValue);
+    connect(_mesher, &occMesher::busyChanged, this, &occWidget::onBusyChanged);
+    connect(_mesher, &occMesher::meshed, this, &occWidget::onShapesMeshed);
+    connect(_cancelButton, &QToolButton::clicked, _mesher, &occMesher::cancel);
+
+    connect(_jobEngine, &occJobEngine::progress, _progressBar, &QProgressBar::setValue);
+    connect(_jobEngine, &occJobEngine::busyChanged, this, &occWidget::onBusyChanged);
+    connect(_jobEngine, &occJobEngine::jobStarted, this, [this](const QString& name) {
+        _statusBar->showMessage(QString("%1...").arg(name));
+    });
+    connect(_jobEngine, &occJobEngine::jobFinished, this, &occWidget::onJobFinished);
+    connect(_jobEngine, &occJobEngine::jobFailed, this, &occWidget::onJobFailed);
+    connect(_cancelButton, &QToolButton::clicked, _jobEngine, &occJobEngine::cancel);
+
+    connect(_benchmark, &occBenchmark::progress, _progressBar, &QProgressBar::setValue);
+    connect(_benchmark, &occBenchmark::finished, this, [this](const QString& summary) {
+        _statusBar->showMessage(QString("Stress test: %1").arg(summary));
+        onBusyChanged();
+    });
+    connect(_cancelButton, &QToolButton::clicked, _benchmark, &occBenchmark::cancel);
+
+    connect(_recorder, &occTurntableRecorder::progress, _progressBar, &QProgressBar::setValue);
+    connect(_recorder, &occTurntableRecorder::finished, this, [this](const QString& summary) {
+        _statusBar->showMessage(QString("Turntable: %1").arg(summary));
+        onBusyChanged();
+    });
+    connect(_cancelButton, &QToolButton::clicked, _recorder, &occTurntableRecorder::cancel);
+
+    connect(_stepImporter, &occStepImporter::progress, _progressBar, &QProgressBar::setValue);
+    connect(_stepImporter, &occStepImporter::partsReady, this, &occWidget::onStepPartsReady);
+    connect(_stepImporter, &occStepImporter::finished, this, [this](const occStepImportReport& report) {
+        _statusBar->showMessage(QString("%1: %2").arg(QFileInfo(report.fileName).fileName(), report.toString()));
+        if (report.error.isEmpty())
+            _occView->fitAll();
+        onBusyChanged();
+    });
+    connect(_cancelButton, &QToolButton::clicked, _stepImporter, &occStepImporter::cancel);
+
+    connect(_stlReader, &occStlReader::progress, _progressBar, &QProgressBar::setValue);
+    connect(_stlReader, &occStlReader::finished, this, &occWidget::onStlRead);
+    connect(_cancelButton, &QToolButton::clicked, _stlReader, &occStlReader::cancel);
+
+    connect(_occView, &occView::progressiveSamplesChanged, this, [this](int samplesPerPixel, double samplesPerSecond) {
+        _statusBar->showMessage(QString("Path tracing: %1 samples per pixel, %2 Msamples/s")
+                                .arg(samplesPerPixel)
+                                .arg(samplesPerSecond / 1.0e6, 0, 'f', 1), 2000);
+    });
+
+    connect(_occView->getImageExporter(), &occImageExporter::saved, this, [this](const QString& fileName, qint64 msecs) {
+        _statusBar->showMessage(QString("Saved %1 in %2 ms").arg(QFileInfo(fileName).fileName()).arg(msecs), 5000);
+    });
+    connect(_occView, &occView::highResolutionImageExported, this, [this](const QString& fileName, const QString& report) {
+        _statusBar->showMessage(QString("%1: %2").arg(QFileInfo(fileName).fileName(), report), 10000);
+    });
+    connect(_occView->getImageExporter(), &occImageExporter::failed, this, [this](const QString& fileName, const QString& reason) {
+        _statusBar->showMessage(QString("Saving %1 failed: %2").arg(QFileInfo(fileName).fileName(), reason), 5000);
+    });
+}
+
+
+void occWidget::onBusyChanged()
+{
+    const bool isBusy = _mesher->isBusy() || _jobEngine->isBusy() || _benchmark->isRunning()
+            || _recorder->isBusy() || _stepImporter->isBusy() || _stlReader->isBusy();
+
+    _progressBar->setValue(0);
+    _progressBar->setVisible(isBusy);
+    _cancelButton->setVisible(isBusy);
+
+    const QString meshingMessage {"Meshing..."};
+    if (isBusy && _statusBar->currentMessage().isEmpty())
+        _statusBar->showMessage(meshingMessage);
+    else if (!isBusy && _statusBar->currentMessage() == meshingMessage)
+        _statusBar->clearMessage();
+}
+
+
+void occWidget::displayShapes(const occShapeList& shapes)
+{
+    _mesher->mesh(shapes);
+}
+
+
+void occWidget::onShapesMeshed(const occShapeList& shapes)
+{
+    occSceneTransaction scene(_occView);
+    for (const auto& shape : shapes)
+        _occView->display(shape);
+}
+
+
+void occWidget::onJobFinished(const QString& name, const occJobResult& result, qint64 msecs)
+{
+    {
+        occSceneTransaction scene(_occView);
+        for (const auto& item : result.shapes)
+        {
+            Handle(AIS_Shape) aisShape = new AIS_Shape(item.shape);
+            if (item.hasColor)
+                setShapeAttributes(aisShape, item.color);
+
+            _occView->display(aisShape);
+        }
+    }
+
+    if (result.report.isEmpty())
+        _statusBar->showMessage(QString("%1 finished in %2 ms").arg(name).arg(msecs), 5000);
+    else
+        _statusBar->showMessage(QString("%1 finished in %2 ms: %3").arg(name).arg(msecs).arg(result.report), 10000);
+}
+
+
+void occWidget::onJobFailed(const QString& name, const QString& reason)
+{
+    _statusBar->showMessage(QString("%1 failed: %2").arg(name, reason), 5000);
+}
+
+
 void occWidget::setShapeAttributes(Handle(AIS_Shape) shape, Quantity_Color color)
 {
-    shape->SetColor(color);
-    auto attrib = shape->Attributes();
-    auto line = attrib->FaceBoundaryAspect();
-    line->SetColor(Quantity_NOC_BLACK);
-    line->SetWidth(2.0);
-    attrib->SetFaceBoundaryDraw(Standard_True);
-    attrib->SetFaceBoundaryAspect(line);
-    shape->SetAttributes(attrib);
+    _styles.apply(shape, color);
 }
 
 
@@ -292,8 +493,7 @@ void occWidget::addBox()
     Handle(AIS_Shape) aisBox = new AIS_Shape(topoBox);
     setShapeAttributes(aisBox, Quantity_NOC_AZURE);
 
-    _occView->getContext()->Display(aisBox, Standard_True);
-    _occView->fitAll();
+    displayShapes({aisBox});
 }
 
 
@@ -312,9 +512,7 @@ void occWidget::addCone()
     Handle(AIS_Shape) aisCone = new AIS_Shape(topoCone);
     setShapeAttributes(aisCone, Quantity_NOC_CHOCOLATE);
 
-    _occView->getContext()->Display(aisReducer, Standard_True);
-    _occView->getContext()->Display(aisCone, Standard_True);
-    _occView->fitAll();
+    displayShapes({aisReducer, aisCone});
 }
 
 
@@ -327,8 +525,7 @@ void occWidget::addSphere()
     Handle(AIS_Shape) aisSphere = new AIS_Shape(topoSphere);
     setShapeAttributes(aisSphere, Quantity_NOC_BLUE1);
 
-    _occView->getContext()->Display(aisSphere, Standard_True);
-    _occView->fitAll();
+    displayShapes({aisSphere});
 }
 
 
@@ -347,9 +544,7 @@ void occWidget::addCylinder()
     Handle(AIS_Shape) aisPie = new AIS_Shape(topoPie);
     setShapeAttributes(aisPie, Quantity_NOC_TAN);
 
-    _occView->getContext()->Display(aisCylinder, Standard_True);
-    _occView->getContext()->Display(aisPie, Standard_True);
-    _occView->fitAll();
+    displayShapes({aisCylinder, aisPie});
 }
 
 
@@ -368,10 +563,7 @@ void occWidget::addTorus()
     Handle(AIS_Shape) aisElbow = new AIS_Shape(topoElbow);
     setShapeAttributes(aisElbow, Quantity_NOC_THISTLE);
 
-    _occView->getContext()->Display(aisTorus, Standard_True);
-    _occView->getContext()->Display(aisElbow, Standard_True);
-
-    _occView->fitAll();
+    displayShapes({aisTorus, aisElbow});
 }
 
 
@@ -403,47 +595,103 @@ void occWidget::addText()
 
 void occWidget::makeFillet()
 {
-    gp_Ax2 axis;
-    axis.SetLocation(gp_Pnt(0.0, 50.0, 0.0));
+    _jobEngine->submit("Fillet", [](const Message_ProgressRange& range) {
+        gp_Ax2 axis;
+        axis.SetLocation(gp_Pnt(0.0, 50.0, 0.0));
 
-    TopoDS_Shape topoBox = BRepPrimAPI_MakeBox(axis, 3.0, 4.0, 5.0).Shape();
-    BRepFilletAPI_MakeFillet MF(topoBox);
+        TopoDS_Shape topoBox = BRepPrimAPI_MakeBox(axis, 3.0, 4.0, 5.0).Shape();
+        BRepFilletAPI_MakeFillet MF(topoBox);
 
-    // Add all the edges to fillet.
-    for (TopExp_Explorer ex(topoBox, TopAbs_EDGE); ex.More(); ex.Next())
-        MF.Add(1.0, TopoDS::Edge(ex.Current()));
+        // Add all the edges to fillet.
+        for (TopExp_Explorer ex(topoBox, TopAbs_EDGE); ex.More(); ex.Next())
+            MF.Add(1.0, TopoDS::Edge(ex.Current()));
 
-    Handle(AIS_Shape) aisShape = new AIS_Shape(MF.Shape());
-    this->setShapeAttributes(aisShape, Quantity_NOC_VIOLET);
+        MF.Build(range);
+        if (!MF.IsDone())
+            return occJobResult();
 
-    _occView->getContext()->Display(aisShape, Standard_True);
-    _occView->fitAll();
+        return occJobResult {{{MF.Shape(), Quantity_NOC_VIOLET}}};
+    });
+}
+
+
+void occWidget::makeFilletInstances()
+{
+    bool ok;
+    const int nbInstances = QInputDialog::getInt(this, "Fillet instances", "Number of copies:",
+                                                 1000, 1, 100000, 100, &ok);
+    if (!ok)
+        return;
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    QElapsedTimer timer;
+    timer.start();
+
+    // the prototype is built once, a new run replaces the copies of the previous one
+    if (_filletPrototype < 0)
+    {
+        TopoDS_Shape topoBox = BRepPrimAPI_MakeBox(3.0, 4.0, 5.0).Shape();
+        BRepFilletAPI_MakeFillet MF(topoBox);
+        for (TopExp_Explorer ex(topoBox, TopAbs_EDGE); ex.More(); ex.Next())
+            MF.Add(1.0, TopoDS::Edge(ex.Current()));
+        MF.Build();
+        if (!MF.IsDone())
+        {
+            QApplication::restoreOverrideCursor();
+            _statusBar->showMessage("Fillet instances: the fillet failed", 5000);
+            return;
+        }
+
+        Handle(AIS_Shape) prototype = new AIS_Shape(MF.Shape());
+        setShapeAttributes(prototype, Quantity_NOC_VIOLET);
+        _filletPrototype = _instancer->addPrototype(prototype);
+    }
+
+    // a square grid of copies next to the other examples
+    const int nbPerRow = static_cast<int>(std::ceil(std::sqrt(nbInstances)));
+    const Standard_Real pitch = 6.0;
+    {
+        occSceneTransaction scene(_occView);
+        _instancer->removeInstances(_filletPrototype);
+        for (int i = 0; i < nbInstances; ++i)
+        {
+            gp_Trsf placement;
+            placement.SetTranslation(gp_Vec(pitch * (i % nbPerRow), -50.0 - pitch * (i / nbPerRow), 0.0));
+            _instancer->place(_filletPrototype, placement);
+        }
+    }
+
+    QApplication::restoreOverrideCursor();
+    _statusBar->showMessage(QString("Fillet instances: %1 copies of one tessellation in %2 ms")
+                            .arg(nbInstances).arg(timer.elapsed()), 10000);
 }
 
 
 void occWidget::makeChamfer()
 {
-    gp_Ax2 axis;
-    axis.SetLocation(gp_Pnt(8.0, 50.0, 0.0));
+    _jobEngine->submit("Chamfer", [](const Message_ProgressRange& range) {
+        gp_Ax2 axis;
+        axis.SetLocation(gp_Pnt(8.0, 50.0, 0.0));
 
-    TopoDS_Shape topoBox = BRepPrimAPI_MakeBox(axis, 3.0, 4.0, 5.0).Shape();
-    BRepFilletAPI_MakeChamfer MC(topoBox);
-    TopTools_IndexedDataMapOfShapeListOfShape aEdgeFaceMap;
+        TopoDS_Shape topoBox = BRepPrimAPI_MakeBox(axis, 3.0, 4.0, 5.0).Shape();
+        BRepFilletAPI_MakeChamfer MC(topoBox);
+        TopTools_IndexedDataMapOfShapeListOfShape aEdgeFaceMap;
 
-    TopExp::MapShapesAndAncestors(topoBox, TopAbs_EDGE, TopAbs_FACE, aEdgeFaceMap);
+        TopExp::MapShapesAndAncestors(topoBox, TopAbs_EDGE, TopAbs_FACE, aEdgeFaceMap);
 
-    for (Standard_Integer i = 1; i <= aEdgeFaceMap.Extent(); ++i)
-    {
-        TopoDS_Edge anEdge = TopoDS::Edge(aEdgeFaceMap.FindKey(i));
-        TopoDS_Face aFace = TopoDS::Face(aEdgeFaceMap.FindFromIndex(i).First());
-        MC.Add(0.6, 0.6, anEdge, aFace);
-    }
+        for (Standard_Integer i = 1; i <= aEdgeFaceMap.Extent(); ++i)
+        {
+            TopoDS_Edge anEdge = TopoDS::Edge(aEdgeFaceMap.FindKey(i));
+            TopoDS_Face aFace = TopoDS::Face(aEdgeFaceMap.FindFromIndex(i).First());
+            MC.Add(0.6, 0.6, anEdge, aFace);
+        }
 
-    Handle(AIS_Shape) aisShape = new AIS_Shape(MC.Shape());
-    setShapeAttributes(aisShape, Quantity_NOC_TOMATO);
+        MC.Build(range);
+        if (!MC.IsDone())
+            return occJobResult();
 
-    _occView->getContext()->Display(aisShape, Standard_True);
-    _occView->fitAll();
+        return occJobResult {{{MC.Shape(), Quantity_NOC_TOMATO}}};
+    });
 }
 
 
@@ -481,11 +729,7 @@ void occWidget::makeExtrude()
     setShapeAttributes(aisPrismCircle, Quantity_NOC_PERU);
     setShapeAttributes(aisPrismEllipse, Quantity_NOC_PINK);
 
-    _occView->getContext()->Display(aisPrismVertex, Standard_True);
-    _occView->getContext()->Display(aisPrismEdge, Standard_True);
-    _occView->getContext()->Display(aisPrismCircle, Standard_True);
-    _occView->getContext()->Display(aisPrismEllipse, Standard_True);
-    _occView->fitAll();
+    displayShapes({aisPrismVertex, aisPrismEdge, aisPrismCircle, aisPrismEllipse});
 }
 
 
@@ -529,148 +773,321 @@ void occWidget::makeRevol()
     setShapeAttributes(aisRevolCircle, Quantity_NOC_MAGENTA1);
     setShapeAttributes(aisRevolEllipse, Quantity_NOC_MAROON);
 
-    _occView->getContext()->Display(aisRevolVertex, Standard_True);
-    _occView->getContext()->Display(aisRevolEdge, Standard_True);
-    _occView->getContext()->Display(aisRevolCircle, Standard_True);
-    _occView->getContext()->Display(aisRevolEllipse, Standard_True);
-    _occView->fitAll();
+    displayShapes({aisRevolVertex, aisRevolEdge, aisRevolCircle, aisRevolEllipse});
 }
 
 
 void occWidget::makeLoft()
 {
-    // bottom wire.
-    TopoDS_Edge circleEdge = BRepBuilderAPI_MakeEdge(
-                gp_Circ(
-                    gp_Ax2(gp_Pnt(0.0, 80.0, 0.0), gp::DZ()),
-                    1.5)
-                );
-    TopoDS_Wire circleWire = BRepBuilderAPI_MakeWire(circleEdge);
-
-    // top wire.
-    BRepBuilderAPI_MakePolygon polygon;
-    polygon.Add(gp_Pnt(-3.0, 77.0, 6.0));
-    polygon.Add(gp_Pnt(3.0, 77.0, 6.0));
-    polygon.Add(gp_Pnt(3.0, 83.0, 6.0));
-    polygon.Add(gp_Pnt(-3.0, 83.0, 6.0));
-    polygon.Close();
+    _jobEngine->submit("Loft", [](const Message_ProgressRange& range) {
+        Message_ProgressScope scope(range, "Loft", 2);
+
+        // bottom wire.
+        TopoDS_Edge circleEdge = BRepBuilderAPI_MakeEdge(
+                    gp_Circ(
+                        gp_Ax2(gp_Pnt(0.0, 80.0, 0.0), gp::DZ()),
+                        1.5)
+                    );
+        TopoDS_Wire circleWire = BRepBuilderAPI_MakeWire(circleEdge);
+
+        // top wire.
+        BRepBuilderAPI_MakePolygon polygon;
+        polygon.Add(gp_Pnt(-3.0, 77.0, 6.0));
+        polygon.Add(gp_Pnt(3.0, 77.0, 6.0));
+        polygon.Add(gp_Pnt(3.0, 83.0, 6.0));
+        polygon.Add(gp_Pnt(-3.0, 83.0, 6.0));
+        polygon.Close();
+
+        BRepOffsetAPI_ThruSections shellGenerator;
+        BRepOffsetAPI_ThruSections solidGenerator(true);
+
+        shellGenerator.AddWire(circleWire);
+        shellGenerator.AddWire(polygon.Wire());
+
+        solidGenerator.AddWire(circleWire);
+        solidGenerator.AddWire(polygon.Wire());
+
+        shellGenerator.Build(scope.Next());
+        solidGenerator.Build(scope.Next());
+        if (!shellGenerator.IsDone() || !solidGenerator.IsDone())
+            return occJobResult();
+
+        // translate the solid.
+        gp_Trsf aTrsf;
+        aTrsf.SetTranslation(gp_Vec(18.0, 0.0, 0.0));
+        BRepBuilderAPI_Transform transform(solidGenerator.Shape(), aTrsf);
+
+        return occJobResult {{{shellGenerator.Shape(), Quantity_NOC_OLIVEDRAB},
+                              {transform.Shape(), Quantity_NOC_PEACHPUFF}}};
+    });
+}
 
-    BRepOffsetAPI_ThruSections shellGenerator;
-    BRepOffsetAPI_ThruSections solidGenerator(true);
 
-    shellGenerator.AddWire(circleWire);
-    shellGenerator.AddWire(polygon.Wire());
+void occWidget::boolCut()
+{
+    _jobEngine->submit("Boolean cut", [options = _booleanOptions](const Message_ProgressRange& range) {
+        Message_ProgressScope scope(range, "Boolean cut", 2);
+        occBooleanService service(options);
+
+        gp_Ax2 axis;
+        axis.SetLocation(gp_Pnt(0.0, 90.0, 0.0));
+
+        TopoDS_Shape topoBox = BRepPrimAPI_MakeBox(axis, 3.0, 4.0, 5.0).Shape();
+        TopoDS_Shape topoSphere = BRepPrimAPI_MakeSphere(axis, 2.5).Shape();
+
+        TopoDS_Shape cutShape1 = service.cut(topoBox, topoSphere, scope.Next());
+        const QString report1 = service.lastReport().toString();
+        TopoDS_Shape cutShape2 = service.cut(topoSphere, topoBox, scope.Next());
+        const QString report2 = service.lastReport().toString();
+        if (cutShape1.IsNull() || cutShape2.IsNull())
+            return occJobResult();
+
+        gp_Trsf aTrsf;
+        aTrsf.SetTranslation(gp_Vec(8.0, 0.0, 0.0));
+        BRepBuilderAPI_Transform transform1(cutShape1, aTrsf);
+
+        aTrsf.SetTranslation(gp_Vec(16.0, 0.0, 0.0));
+        BRepBuilderAPI_Transform transform2(cutShape2, aTrsf);
+
+        return occJobResult {{{topoBox, Quantity_NOC_SPRINGGREEN},
+                              {topoSphere, Quantity_NOC_STEELBLUE},
+                              {transform1.Shape(), Quantity_NOC_TAN},
+                              {transform2.Shape(), Quantity_NOC_SALMON}},
+                             report1 + "; " + report2};
+    });
+}
 
-    solidGenerator.AddWire(circleWire);
-    solidGenerator.AddWire(polygon.Wire());
 
-    // translate the solid.
-    gp_Trsf aTrsf;
-    aTrsf.SetTranslation(gp_Vec(18.0, 0.0, 0.0));
-    BRepBuilderAPI_Transform transform(solidGenerator.Shape(), aTrsf);
+void occWidget::boolFuse()
+{
+    _jobEngine->submit("Boolean fuse", [options = _booleanOptions](const Message_ProgressRange& range) {
+        occBooleanService service(options);
+
+        gp_Ax2 axis;
+        axis.SetLocation(gp_Pnt(0.0, 100.0, 0.0));
+
+        TopoDS_Shape topoBox = BRepPrimAPI_MakeBox(axis, 3.0, 4.0, 5.0).Shape();
+        TopoDS_Shape topoSphere = BRepPrimAPI_MakeSphere(axis, 2.5).Shape();
+        TopoDS_Shape fusedShape = service.fuse(topoBox, topoSphere, range);
+        if (fusedShape.IsNull())
+            return occJobResult();
+
+        gp_Trsf trsf;
+        trsf.SetTranslation(gp_Vec(8.0, 0.0, 0.0));
+        BRepBuilderAPI_Transform transform(fusedShape, trsf);
+
+        return occJobResult {{{topoBox, Quantity_NOC_SPRINGGREEN},
+                              {topoSphere, Quantity_NOC_STEELBLUE},
+                              {transform.Shape(), Quantity_NOC_ROSYBROWN}},
+                             service.lastReport().toString()};
+    });
+}
 
-    Handle(AIS_Shape) aisShell = new AIS_Shape(shellGenerator.Shape());
-    Handle(AIS_Shape) aisSolid = new AIS_Shape(transform.Shape());
 
-    setShapeAttributes(aisShell, Quantity_NOC_OLIVEDRAB);
-    setShapeAttributes(aisSolid, Quantity_NOC_PEACHPUFF);
+void occWidget::boolCommon()
+{
+    _jobEngine->submit("Boolean common", [options = _booleanOptions](const Message_ProgressRange& range) {
+        occBooleanService service(options);
+
+        gp_Ax2 axis;
+        axis.SetLocation(gp_Pnt(0.0, 110.0, 0.0));
+
+        TopoDS_Shape topoBox = BRepPrimAPI_MakeBox(axis, 3.0, 4.0, 5.0).Shape();
+        TopoDS_Shape topoSphere = BRepPrimAPI_MakeSphere(axis, 2.5).Shape();
+        TopoDS_Shape commonShape = service.common(topoBox, topoSphere, range);
+        if (commonShape.IsNull())
+            return occJobResult();
+
+        gp_Trsf trsf;
+        trsf.SetTranslation(gp_Vec(8.0, 0.0, 0.0));
+        BRepBuilderAPI_Transform transform(commonShape, trsf);
+
+        return occJobResult {{{topoBox, Quantity_NOC_SPRINGGREEN},
+                              {topoSphere, Quantity_NOC_STEELBLUE},
+                              {transform.Shape(), Quantity_NOC_ROYALBLUE}},
+                             service.lastReport().toString()};
+    });
+}
 
-    _occView->getContext()->Display(aisShell, Standard_True);
-    _occView->getContext()->Display(aisSolid, Standard_True);
-    _occView->fitAll();
+void occWidget::boolCutBatch()
+{
+    bool ok;
+    const int nbHoles = QInputDialog::getInt(this, "Boolean batch cut", "Number of holes:",
+                                             100, 1, 10000, 1, &ok);
+    if (!ok)
+        return;
+
+    _jobEngine->submit("Boolean batch cut", [options = _booleanOptions, nbHoles](const Message_ProgressRange& range) {
+        Message_ProgressScope scope(range, "Boolean batch cut", 2);
+        occBooleanService service(options);
+
+        // a square plate with a regular grid of drill holes
+        const int nbPerRow = static_cast<int>(std::ceil(std::sqrt(nbHoles)));
+        const Standard_Real pitch = 2.0;
+        const Standard_Real size = nbPerRow * pitch;
+
+        TopoDS_Shape plate = BRepPrimAPI_MakeBox(gp_Pnt(0.0, 140.0, 0.0), size, size, 1.0).Shape();
+
+        TopTools_ListOfShape holes;
+        for (int i = 0; i < nbHoles; ++i)
+        {
+            gp_Ax2 axis;
+            axis.SetLocation(gp_Pnt(pitch * (i % nbPerRow + 0.5), 140.0 + pitch * (i / nbPerRow + 0.5), -1.0));
+            holes.Append(BRepPrimAPI_MakeCylinder(axis, pitch * 0.3, 3.0).Shape());
+        }
+
+        // one tool after the other, every step intersects the growing result again.
+        // a log line per cut would be part of the measured time, one summary follows instead
+        occBooleanOptions pairwiseOptions = options;
+        pairwiseOptions.isLogging = false;
+        occBooleanService pairwiseService(pairwiseOptions);
+
+        Message_ProgressScope pairwiseScope(scope.Next(), "Pairwise cuts", nbHoles);
+        QElapsedTimer timer;
+        timer.start();
+        TopoDS_Shape pairwise = plate;
+        int nbCuts = 0;
+        for (TopTools_ListIteratorOfListOfShape it(holes); it.More() && pairwiseScope.More(); it.Next(), ++nbCuts)
+            pairwise = pairwiseService.cut(pairwise, it.Value(), pairwiseScope.Next());
+        const qint64 pairwiseMsecs = timer.elapsed();
+
+        if (options.isLogging)
+            qInfo().noquote() << QString("Boolean %1 pairwise cuts in %2 ms, mean %3 ms")
+                                 .arg(nbCuts).arg(pairwiseMsecs)
+                                 .arg(nbCuts > 0 ? double(pairwiseMsecs) / nbCuts : 0.0, 0, 'f', 2);
+
+        // all tools in a single intersection pass
+        TopoDS_Shape batch = service.cut(plate, holes, scope.Next());
+        const qint64 batchMsecs = service.lastReport().msecs;
+        if (batch.IsNull() || pairwise.IsNull())
+            return occJobResult();
+
+        const QString report = QString("%1 holes, single pass %2 ms, pairwise %3 ms")
+                .arg(nbHoles).arg(batchMsecs).arg(pairwiseMsecs);
+
+        return occJobResult {{{batch, Quantity_NOC_TAN}}, report};
+    });
 }
 
 
-void occWidget::boolCut()
+void occWidget::runStressTest()
 {
-    gp_Ax2 axis;
-    axis.SetLocation(gp_Pnt(0.0, 90.0, 0.0));
-
-    TopoDS_Shape topoBox = BRepPrimAPI_MakeBox(axis, 3.0, 4.0, 5.0).Shape();
-    TopoDS_Shape topoSphere = BRepPrimAPI_MakeSphere(axis, 2.5).Shape();
-    TopoDS_Shape cutShape1 = BRepAlgoAPI_Cut(topoBox, topoSphere);
-    TopoDS_Shape cutShape2 = BRepAlgoAPI_Cut(topoSphere, topoBox);
+    if (_benchmark->isRunning())
+        return;
+
+    bool ok;
+    occBenchmarkSettings settings;
+    settings.nbObjects = QInputDialog::getInt(this, "Stress test", "Number of primitives:",
+                                              settings.nbObjects, 1, occBenchmark::maxObjects, 1000, &ok);
+    if (!ok)
+        return;
+
+    settings.reportFile = QFileDialog::getSaveFileName(this, "Save benchmark report",
+                                                       "occQt6-benchmark.json", "JSON files (*.json)");
+
+    _statusBar->showMessage("Stress test...");
+    _benchmark->start(settings);
+    onBusyChanged();
+}
 
-    gp_Trsf aTrsf;
-    aTrsf.SetTranslation(gp_Vec(8.0, 0.0, 0.0));
-    BRepBuilderAPI_Transform transform1(cutShape1, aTrsf);
 
-    aTrsf.SetTranslation(gp_Vec(16.0, 0.0, 0.0));
-    BRepBuilderAPI_Transform transform2(cutShape2, aTrsf);
+void occWidget::recordTurntable()
+{
+    if (_recorder->isBusy())
+        return;
+
+    bool ok;
+    occRecorderSettings settings;
+    settings.nbFrames = QInputDialog::getInt(this, "Turntable", "Frames per turn:",
+                                             settings.nbFrames, 2, 3600, 30, &ok);
+    if (!ok)
+        return;
+
+    const QString videoFilter {"MP4 video (*.mp4)"};
+    QString filter;
+    settings.fileName = QFileDialog::getSaveFileName(this, "Record turntable", "turntable.png",
+                                                     "PNG image sequence (*.png);;JPEG image sequence (*.jpg);;" + videoFilter,
+                                                     &filter);
+    if (settings.fileName.isEmpty())
+        return;
+
+    if (filter == videoFilter || settings.fileName.endsWith(".mp4", Qt::CaseInsensitive))
+    {
+        settings.encoder = QStandardPaths::findExecutable("ffmpeg");
+        if (settings.encoder.isEmpty())
+        {
+            QMessageBox::warning(this, "Record turntable", "Recording a video requires ffmpeg in the PATH.");
+            return;
+        }
+    }
 
-    Handle(AIS_Shape) aisBox = new AIS_Shape(topoBox);
-    Handle(AIS_Shape) aisSphere = new AIS_Shape(topoSphere);
-    Handle(AIS_Shape) aisCutShape1 = new AIS_Shape(transform1.Shape());
-    Handle(AIS_Shape) aisCutShape2 = new AIS_Shape(transform2.Shape());
-
-    setShapeAttributes(aisBox, Quantity_NOC_SPRINGGREEN);
-    setShapeAttributes(aisSphere, Quantity_NOC_STEELBLUE);
-    setShapeAttributes(aisCutShape1, Quantity_NOC_TAN);
-    setShapeAttributes(aisCutShape2, Quantity_NOC_SALMON);
-
-    _occView->getContext()->Display(aisBox, Standard_True);
-    _occView->getContext()->Display(aisSphere, Standard_True);
-    _occView->getContext()->Display(aisCutShape1, Standard_True);
-    _occView->getContext()->Display(aisCutShape2, Standard_True);
-    _occView->fitAll();
+    _statusBar->showMessage("Recording turntable...");
+    if (_recorder->start(settings))
+        onBusyChanged();
 }
 
 
-void occWidget::boolFuse()
+void occWidget::importStep()
 {
-    gp_Ax2 axis;
-    axis.SetLocation(gp_Pnt(0.0, 100.0, 0.0));
-
-    TopoDS_Shape topoBox = BRepPrimAPI_MakeBox(axis, 3.0, 4.0, 5.0).Shape();
-    TopoDS_Shape topoSphere = BRepPrimAPI_MakeSphere(axis, 2.5).Shape();
-    TopoDS_Shape fusedShape = BRepAlgoAPI_Fuse(topoBox, topoSphere);
+    if (_stepImporter->isBusy())
+        return;
 
-    gp_Trsf trsf;
-    trsf.SetTranslation(gp_Vec(8.0, 0.0, 0.0));
-    BRepBuilderAPI_Transform transform(fusedShape, trsf);
+    const QString fileName = QFileDialog::getOpenFileName(this, "Import STEP file", QString(),
+                                                          "STEP files (*.step *.stp *.STEP *.STP)");
+    if (fileName.isEmpty())
+        return;
 
-    Handle(AIS_Shape) aisBox = new AIS_Shape(topoBox);
-    Handle(AIS_Shape) aisSphere = new AIS_Shape(topoSphere);
-    Handle(AIS_Shape) aisFusedShape = new AIS_Shape(transform.Shape());
+    _statusBar->showMessage(QString("Importing %1...").arg(QFileInfo(fileName).fileName()));
+    if (_stepImporter->start(fileName))
+        onBusyChanged();
+}
 
-    setShapeAttributes(aisBox, Quantity_NOC_SPRINGGREEN);
-    setShapeAttributes(aisSphere, Quantity_NOC_STEELBLUE);
-    setShapeAttributes(aisFusedShape, Quantity_NOC_ROSYBROWN);
 
-    _occView->getContext()->Display(aisBox, Standard_True);
-    _occView->getContext()->Display(aisSphere, Standard_True);
-    _occView->getContext()->Display(aisFusedShape, Standard_True);
-    _occView->fitAll();
+void occWidget::onStepPartsReady(const occStepPartList& parts)
+{
+    // the view is fitted once the import is finished
+    occSceneTransaction scene(_occView, false);
+    for (const auto& part : parts)
+    {
+        setShapeAttributes(part.shape, part.color);
+        _occView->display(part.shape);
+    }
 }
 
 
-void occWidget::boolCommon()
+void occWidget::importStl()
 {
-    gp_Ax2 axis;
-    axis.SetLocation(gp_Pnt(0.0, 110.0, 0.0));
-
-    TopoDS_Shape topoBox = BRepPrimAPI_MakeBox(axis, 3.0, 4.0, 5.0).Shape();
-    TopoDS_Shape topoSphere = BRepPrimAPI_MakeSphere(axis, 2.5).Shape();
-    TopoDS_Shape commonShape = BRepAlgoAPI_Common(topoBox, topoSphere);
+    if (_stlReader->isBusy())
+        return;
 
-    gp_Trsf trsf;
-    trsf.SetTranslation(gp_Vec(8.0, 0.0, 0.0));
-    BRepBuilderAPI_Transform transform(commonShape, trsf);
+    const QString fileName = QFileDialog::getOpenFileName(this, "Import STL file", QString(),
+                                                          "STL files (*.stl *.STL)");
+    if (fileName.isEmpty())
+        return;
 
-    Handle(AIS_Shape) aisBox = new AIS_Shape(topoBox);
-    Handle(AIS_Shape) aisSphere = new AIS_Shape(topoSphere);
-    Handle(AIS_Shape) aisCommonShape = new AIS_Shape(transform.Shape());
+    _statusBar->showMessage(QString("Importing %1...").arg(QFileInfo(fileName).fileName()));
+    if (_stlReader->start(fileName))
+        onBusyChanged();
+}
 
-    setShapeAttributes(aisBox, Quantity_NOC_SPRINGGREEN);
-    setShapeAttributes(aisSphere, Quantity_NOC_STEELBLUE);
-    setShapeAttributes(aisCommonShape, Quantity_NOC_ROYALBLUE);
 
-    _occView->getContext()->Display(aisBox, Standard_True);
-    _occView->getContext()->Display(aisSphere, Standard_True);
-    _occView->getContext()->Display(aisCommonShape, Standard_True);
-    _occView->fitAll();
+void occWidget::onStlRead(const Handle(Poly_Triangulation)& triangulation, const occStlReport& report)
+{
+    _statusBar->showMessage(QString("%1: %2").arg(QFileInfo(report.fileName).fileName(), report.toString()));
+    onBusyChanged();
+    if (triangulation.IsNull())
+        return;
+
+    // AIS_Triangulation only knows the shaded mode 0
+    Handle(AIS_Triangulation) mesh = new AIS_Triangulation(triangulation);
+    _styles.apply(mesh, Quantity_NOC_GRAY70);
+    _occView->setDisplayMode(mesh, 0);
+
+    occSceneTransaction scene(_occView);
+    _occView->display(mesh);
 }
 
+
 void occWidget::testHelix()
 {
     makeCylindricalHelix();
@@ -685,49 +1102,13 @@ void occWidget::makeCylindricalHelix()
 
     // the pcurve is a 2d line in the parametric space.
     gp_Lin2d line2d(gp_Pnt2d(0.0, 0.0), gp_Dir2d(radius, pitch));
-
-    Handle(Geom2d_TrimmedCurve) segment = GCE2d_MakeSegment(line2d, 0.0, M_PI * 2.0).Value();
-
     Handle(Geom_CylindricalSurface) cylinder = new Geom_CylindricalSurface(gp::XOY(), radius);
 
-    TopoDS_Edge helixEdge = BRepBuilderAPI_MakeEdge(segment, cylinder, 0.0, 6.0 * M_PI).Edge();
-
-    gp_Trsf trsf;
-    trsf.SetTranslation(gp_Vec(0.0, 120.0, 0.0));
-    BRepBuilderAPI_Transform transform(helixEdge, trsf);
-
-    Handle(AIS_Shape) aisHelixCurve = new AIS_Shape(transform.Shape());
-
-    _occView->getContext()->Display(aisHelixCurve, Standard_True);
-
-    // sweep a circle profile along the helix curve.
-    // there is no curve3d in the pcurve edge, so approx one.
-    BRepLib::BuildCurve3d(helixEdge);
-
     gp_Ax2 axis;
     axis.SetDirection(gp_Dir(0.0, 4.0, 1.0));
     axis.SetLocation(gp_Pnt(radius, 0.0, 0.0));
 
-    gp_Circ profileCircle(axis, 0.3);
-
-    TopoDS_Edge profileEdge = BRepBuilderAPI_MakeEdge(profileCircle).Edge();
-    TopoDS_Wire profileWire = BRepBuilderAPI_MakeWire(profileEdge).Wire();
-    TopoDS_Face profileFace = BRepBuilderAPI_MakeFace(profileWire).Face();
-
-    TopoDS_Wire helixWire = BRepBuilderAPI_MakeWire(helixEdge).Wire();
-
-    BRepOffsetAPI_MakePipe pipeMaker(helixWire, profileFace);
-
-    if (pipeMaker.IsDone())
-    {
-        trsf.SetTranslation(gp_Vec(8.0, 120.0, 0.0));
-        BRepBuilderAPI_Transform pipeTransform(pipeMaker.Shape(), trsf);
-
-        Handle(AIS_Shape) aisPipe = new AIS_Shape(pipeTransform.Shape());
-        setShapeAttributes(aisPipe, Quantity_NOC_CORAL);
-        _occView->getContext()->Display(aisPipe, Standard_True);
-        _occView->fitAll();
-    }
+    submitHelix("Cylindrical helix", cylinder, line2d, 6.0 * M_PI, axis, 0.0, 8.0, Quantity_NOC_CORAL);
 }
 
 
@@ -738,47 +1119,13 @@ void occWidget::makeConicalHelix()
 
     // the pcurve is a 2d line in the parametric space.
     gp_Lin2d line2d(gp_Pnt2d(0.0, 0.0), gp_Dir2d(radius, pitch));
-    Handle(Geom2d_TrimmedCurve) segment = GCE2d_MakeSegment(line2d, 0.0, M_PI * 2.0).Value();
-    Handle(Geom_ConicalSurface) cylinder = new Geom_ConicalSurface(gp::XOY(), M_PI / 6.0, radius);
-
-    TopoDS_Edge helixEdge = BRepBuilderAPI_MakeEdge(segment, cylinder, 0.0, 6.0 * M_PI).Edge();
-
-    gp_Trsf trsf;
-    trsf.SetTranslation(gp_Vec(18.0, 120.0, 0.0));
-    BRepBuilderAPI_Transform transform(helixEdge, trsf);
-
-    Handle(AIS_Shape) aisHelixCurve = new AIS_Shape(transform.Shape());
-
-    _occView->getContext()->Display(aisHelixCurve, Standard_True);
-
-    // sweep a circle profile along the helix curve.
-    // there is no curve3d in the pcurve edge, so approx one.
-    BRepLib::BuildCurve3d(helixEdge);
+    Handle(Geom_ConicalSurface) cone = new Geom_ConicalSurface(gp::XOY(), M_PI / 6.0, radius);
 
     gp_Ax2 axis;
     axis.SetDirection(gp_Dir(0.0, 4.0, 1.0));
     axis.SetLocation(gp_Pnt(radius, 0.0, 0.0));
 
-    gp_Circ profileCircle(axis, 0.3);
-
-    TopoDS_Edge profileEdge = BRepBuilderAPI_MakeEdge(profileCircle).Edge();
-    TopoDS_Wire profileWire = BRepBuilderAPI_MakeWire(profileEdge).Wire();
-    TopoDS_Face profileFace = BRepBuilderAPI_MakeFace(profileWire).Face();
-
-    TopoDS_Wire helixWire = BRepBuilderAPI_MakeWire(helixEdge).Wire();
-
-    BRepOffsetAPI_MakePipe pipeMaker(helixWire, profileFace);
-
-    if (pipeMaker.IsDone())
-    {
-        trsf.SetTranslation(gp_Vec(28.0, 120.0, 0.0));
-        BRepBuilderAPI_Transform pipeTransform(pipeMaker.Shape(), trsf);
-
-        Handle(AIS_Shape) aisPipe = new AIS_Shape(pipeTransform.Shape());
-        setShapeAttributes(aisPipe, Quantity_NOC_DARKGOLDENROD);
-        _occView->getContext()->Display(aisPipe, Standard_True);
-        _occView->fitAll();
-    }
+    submitHelix("Conical helix", cone, line2d, 6.0 * M_PI, axis, 18.0, 28.0, Quantity_NOC_DARKGOLDENROD);
 }
 
 
@@ -789,45 +1136,61 @@ void occWidget::makeToroidalHelix()
 
     // the pcurve is a 2d line in the parametric space.
     gp_Lin2d line2d(gp_Pnt2d(0.0, 0.0), gp_Dir2d(slope, 1.0));
-    Handle(Geom2d_TrimmedCurve) segment = GCE2d_MakeSegment(line2d, 0.0, M_PI * 2.0).Value();
-    Handle(Geom_ToroidalSurface) cylinder = new Geom_ToroidalSurface(gp::XOY(), radius * 5.0, radius);
+    Handle(Geom_ToroidalSurface) torus = new Geom_ToroidalSurface(gp::XOY(), radius * 5.0, radius);
 
-    TopoDS_Edge helixEdge = BRepBuilderAPI_MakeEdge(segment, cylinder, 0.0, 2.0 * M_PI / slope).Edge();
+    gp_Ax2 axis;
+    axis.SetDirection(gp_Dir(0.0, 0.0, 1.0));
+    axis.SetLocation(gp_Pnt(radius * 6.0, 0.0, 0.0));
 
-    gp_Trsf trsf;
-    trsf.SetTranslation(gp_Vec(45.0, 120.0, 0.0));
-    BRepBuilderAPI_Transform transform(helixEdge, trsf);
+    submitHelix("Toroidal helix", torus, line2d, 2.0 * M_PI / slope, axis, 45.0, 60.0, Quantity_NOC_CORNSILK1);
+}
 
-    Handle(AIS_Shape) aisHelixCurve = new AIS_Shape(transform.Shape());
 
-    _occView->getContext()->Display(aisHelixCurve, Standard_True);
+void occWidget::submitHelix(const QString& name, const Handle(Geom_Surface)& surface, const gp_Lin2d& line2d,
+                            Standard_Real length, const gp_Ax2& profileAxis,
+                            Standard_Real helixX, Standard_Real pipeX, const Quantity_Color& color)
+{
+    _jobEngine->submit(name, [name, surface, line2d, length, profileAxis, helixX, pipeX, color](const Message_ProgressRange& range) {
+        Message_ProgressScope scope(range, TCollection_AsciiString(name.toUtf8().constData()), 2);
 
-    // sweep a circle profile along the helix curve.
-    // there is no curve3d in the pcurve edge, so approx one.
-    BRepLib::BuildCurve3d(helixEdge);
+        Handle(Geom2d_TrimmedCurve) segment = GCE2d_MakeSegment(line2d, 0.0, M_PI * 2.0).Value();
+        TopoDS_Edge helixEdge = BRepBuilderAPI_MakeEdge(segment, surface, 0.0, length).Edge();
 
-    gp_Ax2 axis;
-    axis.SetDirection(gp_Dir(0.0, 0.0, 1.0));
-    axis.SetLocation(gp_Pnt(radius * 6.0, 0.0, 0.0));
+        gp_Trsf trsf;
+        trsf.SetTranslation(gp_Vec(helixX, 120.0, 0.0));
+        BRepBuilderAPI_Transform transform(helixEdge, trsf);
 
-    gp_Circ profileCircle(axis, 0.3);
+        occJobResult result {{{transform.Shape(), Quantity_NOC_BLACK, false}}};
 
-    TopoDS_Edge profileEdge = BRepBuilderAPI_MakeEdge(profileCircle).Edge();
-    TopoDS_Wire profileWire = BRepBuilderAPI_MakeWire(profileEdge).Wire();
-    TopoDS_Face profileFace = BRepBuilderAPI_MakeFace(profileWire).Face();
+        // sweep a circle profile along the helix curve.
+        // there is no curve3d in the pcurve edge, so approx one.
+        BRepLib::BuildCurve3d(helixEdge);
+        scope.Next();
+        if (scope.UserBreak())
+            return occJobResult();
 
-    TopoDS_Wire helixWire = BRepBuilderAPI_MakeWire(helixEdge).Wire();
+        gp_Circ profileCircle(profileAxis, 0.3);
 
-    BRepOffsetAPI_MakePipe pipeMaker(helixWire, profileFace);
+        TopoDS_Edge profileEdge = BRepBuilderAPI_MakeEdge(profileCircle).Edge();
+        TopoDS_Wire profileWire = BRepBuilderAPI_MakeWire(profileEdge).Wire();
+        TopoDS_Face profileFace = BRepBuilderAPI_MakeFace(profileWire).Face();
 
-    if (pipeMaker.IsDone())
-    {
-        trsf.SetTranslation(gp_Vec(60.0, 120.0, 0.0));
-        BRepBuilderAPI_Transform pipeTransform(pipeMaker.Shape(), trsf);
+        TopoDS_Wire helixWire = BRepBuilderAPI_MakeWire(helixEdge).Wire();
 
-        Handle(AIS_Shape) aisPipe = new AIS_Shape(pipeTransform.Shape());
-        setShapeAttributes(aisPipe, Quantity_NOC_CORNSILK1);
-        _occView->getContext()->Display(aisPipe, Standard_True);
-        _occView->fitAll();
-    }
+        // the sweep runs in the constructor and takes no progress range, a cancel
+        // requested meanwhile drops its result
+        BRepOffsetAPI_MakePipe pipeMaker(helixWire, profileFace);
+        scope.Next();
+        if (scope.UserBreak())
+            return occJobResult();
+
+        if (pipeMaker.IsDone())
+        {
+            trsf.SetTranslation(gp_Vec(pipeX, 120.0, 0.0));
+            BRepBuilderAPI_Transform pipeTransform(pipeMaker.Shape(), trsf);
+            result.shapes.append({pipeTransform.Shape(), color});
+        }
+
+        return result;
+    });
 }
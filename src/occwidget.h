@@ -30,13 +30,29 @@
 #define OCCTWIDGET_H
 
 // Qt headers
+#include <QProgressBar>
+#include <QStatusBar>
 #include <QToolBar>
+#include <QToolButton>
 #include <QWidget>
 
 // occ headers
 #include <AIS_ColoredShape.hxx>
+#include <Geom_Surface.hxx>
+#include <gp_Ax2.hxx>
+#include <gp_Lin2d.hxx>
 
 // project headers
+#include "occbenchmark.h"
+#include "occbooleanservice.h"
+#include "occinstancer.h"
+#include "occjobengine.h"
+#include "occmesher.h"
+#include "occselectionmodes.h"
+#include "occstepimporter.h"
+#include "occstlreader.h"
+#include "occstyleregistry.h"
+#include "occturntablerecorder.h"
 #include "occview.h"
 
 class occWidget : public QWidget
@@ -47,19 +63,52 @@ public:
     occWidget(QWidget *parent = nullptr);
     ~occWidget() = default;
 
+    // options used by all Boolean operations started from the toolbar
+    const occBooleanOptions& booleanOptions() const {return _booleanOptions;}
+    void setBooleanOptions(const occBooleanOptions& options) {_booleanOptions = options;}
+
 private:
     occView* _occView;
 
     QToolBar* _toolBar;
 
+    // background meshing, modeling jobs and their progress display
+    occMesher* _mesher;
+    occJobEngine* _jobEngine;
+    QStatusBar* _statusBar;
+    QProgressBar* _progressBar;
+    QToolButton* _cancelButton;
+
+    occBooleanOptions _booleanOptions;
+
+    occBenchmark* _benchmark;
+    occTurntableRecorder* _recorder;
+    occStepImporter* _stepImporter;
+    occStlReader* _stlReader;
+    occInstancer* _instancer;
+    int _filletPrototype {-1};
+
+    // shared drawers of the demo shapes, one per color
+    occStyleRegistry _styles;
+
+    void onViewerInitialized();
+
     void about();
     QAction* addActionToToolBar(QString iconText,
                                 QString iconFileName,
                                 QString toolTipText);
 
     void populateToolBar();
+    void populateStatusBar();
     void setShapeAttributes(Handle(AIS_Shape) shape, Quantity_Color color);
 
+    // mesh the shapes in the background and display them when done
+    void displayShapes(const occShapeList& shapes);
+    void onShapesMeshed(const occShapeList& shapes);
+    void onJobFinished(const QString& name, const occJobResult& result, qint64 msecs);
+    void onJobFailed(const QString& name, const QString& reason);
+    void onBusyChanged();
+
     void addBox();
     void addCone();
     void addSphere();
@@ -76,10 +125,29 @@ private:
     void boolCut();
     void boolFuse();
     void boolCommon();
+    void boolCutBatch();
+
+    void makeFilletInstances();
 
     void testHelix();
     void makeCylindricalHelix();
     void makeConicalHelix();
     void makeToroidalHelix();
+
+    // sweep a circle along a helix given as a 2d line on the surface, the helix is shown at helixX
+    void submitHelix(const QString& name, const Handle(Geom_Surface)& surface, const gp_Lin2d& line2d,
+                     Standard_Real length, const gp_Ax2& profileAxis,
+                     Standard_Real helixX, Standard_Real pipeX, const Quantity_Color& color);
+
+    void runStressTest();
+    void recordTurntable();
+
+    // import STEP files, the parts are displayed while the rest is still meshed
+    void importStep();
+    void onStepPartsReady(const occStepPartList& parts);
+
+    // import STL scans as one triangulation, without faces
+    void importStl();
+    void onStlRead(const Handle(Poly_Triangulation)& triangulation, const occStlReport& report);
 };
 #endif // OCCTWIDGET_H
@@ -0,0 +1,48 @@
+##### MIT ####################################################################
+# This file is part of occQt6, a simple OpenCASCADE Qt demo, updated         #
+# for Qt6 and OpenCASCADE 7.5.0                                              #
+#                                                                            #
+# Copyright (c) 2021  Marius S. Schollmeier                                  #
+#                                                                            #
+# Permission is hereby granted, free of charge, to any person obtaining a    #
+# copy of this software and associated documentation files (the "Software"), #
+# to deal in the Software without restriction, including without limitation  #
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,   #
+# and/or sell copies of the Software, and to permit persons to whom the      #
+# Software is furnished to do so, subject to the following conditions:       #
+#                                                                            #
+# The above copyright notice and this permission notice shall be included    #
+# in all copies or substantial portions of the Software.                     #
+#                                                                            #
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS    #
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF                 #
+# MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.     #
+# IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY       #
+# CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,       #
+# TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE          #
+# SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                     #
+#                                                                            #
+##############################################################################
+
+
+# Build tool that rasterizes the icons of icons.qrc into a packed atlas and
+# writes it, together with its index, to a header used by hirespixmap.h.
+# Built and run by occQt6.pro when configured with CONFIG+=iconatlas.
+
+QT       += core gui svg
+
+TARGET = iconatlas
+TEMPLATE = app
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+DESTDIR = $$OUT_PWD
+
+INCLUDEPATH += $$PWD/../../src
+
+HEADERS += \
+    ../../src/hirespixmap.h
+
+SOURCES += \
+    main.cpp
@@ -0,0 +1,250 @@
+/***** MIT *******************************************************************
+**                                                                          **
+** This file is part of occQt6, a simple OpenCASCADE Qt demo, updated       **
+** for Qt6 and OpenCASCADE 7.5.0                                            **
+**                                                                          **
+** Copyright (c) 2020 Marius Schollmeier (mschollmeier01@gmail.com)         **
+**                                                                          **
+** Permission is hereby granted, free of charge, to any person              **
+** obtaining a copy of this software and associated documentation           **
+** files (the "Software"), to deal in the Software without restriction,     **
+** including without limitation the rights to use, copy, modify, merge,     **
+** publish, distribute, sublicense, and/or sell copies of the Software,     **
+** and to permit persons to whom the Software is furnished to do so,        **
+** subject to the following conditions:                                     **
+**                                                                          **
+** The above copyright notice and this permission notice shall be included  **
+** in all copies or substantial portions of the Software.                   **
+**                                                                          **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          **
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES          **
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND                 **
+** NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT              **
+** HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,             **
+** WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,       **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER            **
+** DEALINGS IN THE SOFTWARE.                                                **
+*****************************************************************************/
+
+// iconatlas renders every SVG listed in a .qrc file with the same pipeline as
+// hiresPixmap(), packs the results into a single image and writes a header with
+// the PNG encoded atlas and the position of every icon in it.
+
+#include <algorithm>
+
+#include <QBuffer>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QPainter>
+#include <QSaveFile>
+#include <QXmlStreamReader>
+
+#include "hirespixmap.h"
+
+namespace
+{
+struct atlasIcon
+{
+    QString resource;   // resource path, e.g. :/icons/lucide/box.svg
+    int height;         // height argument of hiresPixmap()
+    QPixmap pixmap;
+    QPoint position;
+};
+
+// SVG files of a qrc file as pairs of resource path and file on disk
+QList<QPair<QString, QString>> readQrc(const QString& qrcFile, QString* error)
+{
+    QList<QPair<QString, QString>> files;
+
+    QFile file(qrcFile);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        *error = QString("cannot read %1: %2").arg(qrcFile, file.errorString());
+        return files;
+    }
+
+    const QDir baseDir = QFileInfo(qrcFile).absoluteDir();
+    QString prefix {"/"};
+    QXmlStreamReader xml(&file);
+    while (!xml.atEnd())
+    {
+        if (!xml.readNextStartElement())
+            continue;
+
+        if (xml.name() == QLatin1String("qresource"))
+        {
+            prefix = xml.attributes().value("prefix").toString();
+            if (!prefix.endsWith('/'))
+                prefix.append('/');
+        }
+        else if (xml.name() == QLatin1String("file"))
+        {
+            const QString alias = xml.attributes().value("alias").toString();
+            const QString path = xml.readElementText();
+            if (path.endsWith(".svg", Qt::CaseInsensitive))
+                files.append({":" + prefix + (alias.isEmpty() ? path : alias), baseDir.filePath(path)});
+        }
+    }
+
+    if (xml.hasError())
+        *error = QString("%1: %2").arg(qrcFile, xml.errorString());
+    return files;
+}
+
+// shelf packing, tallest icons first
+QSize pack(QList<atlasIcon>& icons, int maxWidth)
+{
+    std::stable_sort(icons.begin(), icons.end(), [](const atlasIcon& a, const atlasIcon& b) {
+        return a.pixmap.height() > b.pixmap.height();
+    });
+
+    int x = 0;
+    int y = 0;
+    int shelfHeight = 0;
+    int width = 0;
+    for (auto& icon : icons)
+    {
+        if (x > 0 && x + icon.pixmap.width() > maxWidth)
+        {
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+        icon.position = QPoint(x, y);
+        x += icon.pixmap.width();
+        width = std::max(width, x);
+        shelfHeight = std::max(shelfHeight, icon.pixmap.height());
+    }
+    return QSize(width, y + shelfHeight);
+}
+
+QByteArray header(const QList<atlasIcon>& icons, const QByteArray& png,
+                  const QString& color, qreal devicePixelRatio)
+{
+    QByteArray out;
+    out += "// generated by tools/iconatlas, do not edit\n\n";
+    out += "#ifndef ICONATLAS_H\n#define ICONATLAS_H\n\n";
+    out += "struct iconAtlasEntry\n{\n"
+           "    const char* resource;\n"
+           "    int height;\n"
+           "    int x;\n"
+           "    int y;\n"
+           "    int width;\n"
+           "    int pixelHeight;\n"
+           "};\n\n";
+    out += QString("inline constexpr char iconAtlasColor[] {\"%1\"};\n").arg(color).toUtf8();
+    out += QString("inline constexpr double iconAtlasDevicePixelRatio {%1};\n\n").arg(devicePixelRatio).toUtf8();
+
+    out += "inline constexpr iconAtlasEntry iconAtlasEntries[] {\n";
+    for (const auto& icon : icons)
+    {
+        out += QString("    {\"%1\", %2, %3, %4, %5, %6},\n")
+                .arg(icon.resource)
+                .arg(icon.height)
+                .arg(icon.position.x())
+                .arg(icon.position.y())
+                .arg(icon.pixmap.width())
+                .arg(icon.pixmap.height()).toUtf8();
+    }
+    out += "};\n\n";
+
+    out += "inline constexpr unsigned char iconAtlasPng[] {";
+    for (int i = 0; i < png.size(); i++)
+    {
+        if (i % 16 == 0)
+            out += "\n   ";
+        out += " 0x" + QByteArray::number(static_cast<uchar>(png.at(i)), 16).rightJustified(2, '0') + ",";
+    }
+    out += "\n};\n\n#endif // ICONATLAS_H\n";
+
+    return out;
+}
+}
+
+
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QGuiApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Rasterize the SVG icons of a resource file into an atlas header.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("qrc", "Resource file listing the icons.");
+    parser.addPositionalArgument("header", "Header file to write.");
+    parser.addOption({"heights", "Comma separated icon heights passed to hiresPixmap().", "list", "16,24,32"});
+    parser.addOption({"color", "Icon color.", "color", "#778ca3"});
+    parser.addOption({"max-width", "Maximum width of the atlas in pixels.", "pixels", "2048"});
+    parser.process(app);
+
+    const QStringList arguments = parser.positionalArguments();
+    if (arguments.size() != 2)
+        parser.showHelp(1);
+
+    QList<int> heights;
+    for (const auto& height : parser.value("heights").split(',', Qt::SkipEmptyParts))
+    {
+        const int value = height.trimmed().toInt();
+        if (value <= 0)
+        {
+            qCritical("iconatlas: invalid height %s", qPrintable(height));
+            return 1;
+        }
+        heights.append(value);
+    }
+
+    QString error;
+    const auto files = readQrc(arguments.at(0), &error);
+    if (!error.isEmpty())
+    {
+        qCritical("iconatlas: %s", qPrintable(error));
+        return 1;
+    }
+
+    // keep in sync with hiresPixmap()
+    const qreal devicePixelRatio = 2.0;
+    const QString color = parser.value("color");
+
+    QList<atlasIcon> icons;
+    for (const auto& file : files)
+        for (const int height : heights)
+            icons.append({file.first, height, renderHiresPixmap(file.second, height, color, devicePixelRatio), QPoint()});
+
+    const QSize size = pack(icons, std::max(1, parser.value("max-width").toInt()));
+    QImage atlas(size.expandedTo(QSize(1, 1)), QImage::Format_ARGB32_Premultiplied);
+    atlas.fill(Qt::transparent);
+    {
+        QPainter painter(&atlas);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        for (const auto& icon : std::as_const(icons))
+        {
+            QImage image = icon.pixmap.toImage();
+            image.setDevicePixelRatio(1.0);
+            painter.drawImage(icon.position, image);
+        }
+    }
+
+    QByteArray png;
+    QBuffer buffer(&png);
+    buffer.open(QIODevice::WriteOnly);
+    atlas.save(&buffer, "PNG");
+
+    QSaveFile out(arguments.at(1));
+    if (!QDir().mkpath(QFileInfo(arguments.at(1)).absolutePath())
+            || !out.open(QIODevice::WriteOnly)
+            || out.write(header(icons, png, color, devicePixelRatio)) < 0
+            || !out.commit())
+    {
+        qCritical("iconatlas: cannot write %s: %s", qPrintable(arguments.at(1)), qPrintable(out.errorString()));
+        return 1;
+    }
+
+    qInfo("iconatlas: %lld icons, %dx%d pixels, %lld bytes",
+          static_cast<long long>(icons.size()), atlas.width(), atlas.height(), static_cast<long long>(png.size()));
+    return 0;
+}